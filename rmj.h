@@ -33,31 +33,522 @@
 // N.B. - the test/sample code in t0.cpp is heavily dependent on STREAM output
 //#define NO_STREAM 1
 //#define NO_FORMAT 1
+// ... while this one disables the [x86/x64] SSE2 / AVX2 "fast paths" entirely
+//#define NO_SIMD 1
+// ... and this one makes js_val::parse_lines use only the calling thread (and
+// key_table NOT thread-safe)
+//#define NO_THREADS 1
+// ... and this one makes mapped_file (and so js_val::parse_file) simply READ
+// the file into memory, rather than "memory-mapping" it
+//#define NO_MMAP 1
+
+// uncomment the below to store js_obj members in a "flat" sorted vector (see
+// rmj::flat_map) instead of a std::map, for more cache-friendly objects
+//#define USE_FLAT_MAP 1
+// ... OR the below to keep js_obj members in their ORIGINAL (document) order,
+// with a hash index for lookups (see rmj::ordered_map), for "byte-stable" round
+// trips of parsed JSON text
+//#define USE_ORDERED_MAP 1
+
+// uncomment the below to build js_val trees using std::pmr "memory resources",
+// which enables both js_doc AND the parse_opts::mr option (see below)
+// N.B. - this changes the js_val string type (js_str) to std::pmr::string
+//#define USE_PMR 1
+
+#if defined(USE_FLAT_MAP) && defined(USE_ORDERED_MAP)
+#error "only ONE of USE_FLAT_MAP and USE_ORDERED_MAP may be defined"
+#endif
 
 #include <string>
 #include <string_view>
+#include <algorithm>
 #include <map>
+#include <functional>
+#include <memory>
+#include <initializer_list>
+#include <tuple>
+#include <utility>
 #include <vector>
 #include <charconv>
 #include <stdexcept>
 #include <concepts>
+#include <type_traits>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <iterator>
+#include <span>
+#include <limits>
+#include <cmath>
+#include <unordered_set>
+#ifndef NO_THREADS
+#include <thread>
+#include <latch>
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+#endif
+#include <filesystem>
+#include <system_error>
+#ifdef USE_PMR
+#include <memory_resource>
+#endif
+#if defined(NO_MMAP)
+#include <fstream>
+#elif defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN 1
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX 1 // (PLEASE don't break std::min and std::max!)
+#endif
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 #ifndef NO_STREAM
 #include <ostream>
+#include <istream>
 #include <ios>
 #endif
 #ifndef NO_FORMAT
 #include <format>
 #endif
 #include "variant.hpp"
+#ifndef NO_SIMD
+#if defined(__AVX2__)
+#define RMJ_AVX2 1
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RMJ_SSE2 1
+#include <emmintrin.h>
+#endif
+#endif
 
 namespace rmj {
 
 using namespace std::string_literals;
 using namespace std::string_view_literals;
 
+// (select "standard" OR "polymorphic" allocators for ALL js_val contents)
+#ifdef USE_PMR
+template<typename T>
+using js_alloc = std::pmr::polymorphic_allocator<T>;
+using js_str = std::pmr::string;
+#else
+template<typename T>
+using js_alloc = std::allocator<T>;
+using js_str = std::string;
+#endif
+
+/*
+	const_key_iterator adapts an iterator over the std::pair<K, T>s in which both
+	flat_map and ordered_map store their members (so that members can be moved
+	about freely as others are inserted or erased), to one over their value_type
+	std::pair<const K, T>s... so that, just as with std::map, a member's key can
+	NOT be changed through an iterator (which would break either map's lookups).
+*/
+template<class It, class V>
+class const_key_iterator {
+	template<class, class> friend class const_key_iterator;
+	It i{};
+
+public:
+	using iterator_category = std::random_access_iterator_tag;
+	using value_type = std::remove_const_t<V>;
+	using difference_type = std::ptrdiff_t;
+	using pointer = V*;
+	using reference = V&;
+
+	constexpr const_key_iterator() = default;
+	constexpr explicit const_key_iterator(It i) noexcept : i(i) {}
+	// (so an iterator converts to a const_iterator, but NOT vice versa)
+	template<class J, class W>
+		requires std::convertible_to<J, It>
+	constexpr const_key_iterator(const const_key_iterator<J, W>& o) noexcept : i(o.i) {}
+
+	// the underlying iterator, over the std::pair<K, T>s
+	constexpr It base() const noexcept { return i; }
+
+	// (N.B. - std::pair<K, T> and std::pair<const K, T> differ ONLY in first's constness)
+	reference operator*() const noexcept { return *reinterpret_cast<pointer>(std::addressof(*i)); }
+	pointer operator->() const noexcept { return std::addressof(**this); }
+	reference operator[](difference_type n) const noexcept { return *(*this + n); }
+
+	constexpr const_key_iterator& operator++() noexcept { return ++i, *this; }
+	constexpr const_key_iterator operator++(int) noexcept { return const_key_iterator{ i++ }; }
+	constexpr const_key_iterator& operator--() noexcept { return --i, *this; }
+	constexpr const_key_iterator operator--(int) noexcept { return const_key_iterator{ i-- }; }
+	constexpr const_key_iterator& operator+=(difference_type n) noexcept { return i += n, *this; }
+	constexpr const_key_iterator& operator-=(difference_type n) noexcept { return i -= n, *this; }
+	friend constexpr const_key_iterator operator+(const_key_iterator a, difference_type n) noexcept { return a += n; }
+	friend constexpr const_key_iterator operator+(difference_type n, const_key_iterator a) noexcept { return a += n; }
+	friend constexpr const_key_iterator operator-(const_key_iterator a, difference_type n) noexcept { return a -= n; }
+	friend constexpr difference_type operator-(const const_key_iterator& a, const const_key_iterator& b) noexcept { return a.i - b.i; }
+	friend constexpr bool operator==(const const_key_iterator& a, const const_key_iterator& b) noexcept { return a.i == b.i; }
+	friend constexpr auto operator<=>(const const_key_iterator& a, const const_key_iterator& b) noexcept { return a.i <=> b.i; }
+};
+
+/*
+	flat_map is a [mostly] drop-in replacement for std::map, storing its members
+	as a contiguous vector of key/value pairs kept sorted by key... so lookups are
+	binary searches over adjacent memory rather than red-black tree walks, and a
+	member costs NO separate allocation of its own.  Iteration, comparisons and
+	"first key wins" insertion semantics are exactly those of std::map.
+
+	N.B. - inserting a key not already present is O(n), which is fine for the
+	small-to-medium objects typical of JSON, while js_val::parse avoids this by
+	appending ALL members of an object unsorted, and then sorting them just once.
+*/
+template<typename K, typename T, typename Cmp = std::less<>, typename Alloc = std::allocator<std::pair<K, T>>>
+class flat_map {
+public:
+	using key_type = K;
+	using mapped_type = T;
+	using value_type = std::pair<const K, T>;
+	using key_compare = Cmp;
+	using allocator_type = Alloc;
+	using size_type = size_t;
+	using container_type = std::vector<std::pair<K, T>, Alloc>;
+	using iterator = const_key_iterator<typename container_type::iterator, value_type>;
+	using const_iterator = const_key_iterator<typename container_type::const_iterator, const value_type>;
+
+	flat_map() = default;
+	explicit flat_map(const Alloc& a) : v(a) {}
+	flat_map(std::initializer_list<value_type> il, const Alloc& a = Alloc()) : v(il.begin(), il.end(), a) { sort_unique(); }
+
+	constexpr auto get_allocator() const noexcept { return v.get_allocator(); }
+	constexpr iterator begin() noexcept { return iterator{ v.begin() }; }
+	constexpr const_iterator begin() const noexcept { return const_iterator{ v.begin() }; }
+	constexpr iterator end() noexcept { return iterator{ v.end() }; }
+	constexpr const_iterator end() const noexcept { return const_iterator{ v.end() }; }
+	constexpr const_iterator cbegin() const noexcept { return begin(); }
+	constexpr const_iterator cend() const noexcept { return end(); }
+	constexpr auto size() const noexcept { return v.size(); }
+	constexpr auto empty() const noexcept { return v.empty(); }
+	constexpr void clear() noexcept { v.clear(); }
+	constexpr void reserve(size_type n) { v.reserve(n); }
+
+	template<class Q> constexpr iterator lower_bound(const Q& k) {
+		return iterator{ std::lower_bound(v.begin(), v.end(), k, [](const auto& e, const Q& k) { return Cmp{}(e.first, k); }) };
+	}
+	template<class Q> constexpr const_iterator lower_bound(const Q& k) const {
+		return const_iterator{ std::lower_bound(v.begin(), v.end(), k, [](const auto& e, const Q& k) { return Cmp{}(e.first, k); }) };
+	}
+	template<class Q> constexpr iterator find(const Q& k) {
+		const auto i{ lower_bound(k) };
+		return i != end() && !Cmp{}(k, i->first) ? i : end();
+	}
+	template<class Q> constexpr const_iterator find(const Q& k) const {
+		const auto i{ lower_bound(k) };
+		return i != end() && !Cmp{}(k, i->first) ? i : end();
+	}
+	template<class Q> constexpr bool contains(const Q& k) const { return find(k) != end(); }
+	template<class Q> constexpr size_type count(const Q& k) const { return contains(k) ? 1 : 0; }
+	template<class Q> constexpr T& at(const Q& k) {
+		if (const auto i{ find(k) }; i != end())
+			return i->second;
+		throw std::out_of_range("flat_map::at: key not found");
+	}
+	template<class Q> constexpr const T& at(const Q& k) const {
+		if (const auto i{ find(k) }; i != end())
+			return i->second;
+		throw std::out_of_range("flat_map::at: key not found");
+	}
+	template<class Q> constexpr T& operator[](Q&& k) { return try_emplace(std::forward<Q>(k)).first->second; }
+
+	// (as with std::map, do NOTHING if the key is already present)
+	template<class Q, class... Args>
+	constexpr std::pair<iterator, bool> try_emplace(Q&& k, Args&&... args) {
+		if (const auto i{ lower_bound(k) }; i != end() && !Cmp{}(k, i->first))
+			return { i, false };
+		else
+			return { iterator{ v.emplace(i.base(), std::piecewise_construct,
+				std::forward_as_tuple(std::forward<Q>(k)), std::forward_as_tuple(std::forward<Args>(args)...)) }, true };
+	}
+	constexpr std::pair<iterator, bool> insert(const value_type& e) { return try_emplace(e.first, e.second); }
+	constexpr std::pair<iterator, bool> insert(value_type&& e) { return try_emplace(std::move(e.first), std::move(e.second)); }
+	template<class... Args>
+	constexpr std::pair<iterator, bool> emplace(Args&&... args) {
+		std::pair<K, T> e(std::forward<Args>(args)...);
+		return try_emplace(std::move(e.first), std::move(e.second));
+	}
+	constexpr iterator erase(const_iterator i) { return iterator{ v.erase(i.base()) }; }
+	template<class Q>
+		requires (!std::convertible_to<const Q&, const_iterator>)
+	constexpr size_type erase(const Q& k) {
+		if (const auto i{ find(k) }; i != end())
+			return erase(i), 1;
+		return 0;
+	}
+
+	// "bulk" construction: append members in ANY order, then call sort_unique()
+	// N.B. - until that is done, NO lookups (or insertions) may be performed!
+	template<class Q, class... Args>
+	constexpr void append_unsorted(Q&& k, Args&&... args) {
+		v.emplace_back(std::piecewise_construct,
+			std::forward_as_tuple(std::forward<Q>(k)), std::forward_as_tuple(std::forward<Args>(args)...));
+	}
+	// (stable sort by key, then keep only the FIRST of any duplicated keys)
+	constexpr void sort_unique() {
+		const auto n{ v.size() };
+		auto less = [this](size_type a, size_type b) { return Cmp{}(v[a].first, v[b].first); };
+		// (a great many objects arrive ALREADY sorted, and with NO duplicates)
+		size_type i{ 1 };
+		while (i < n && less(i - 1, i))
+			++i;
+		if (i >= n)
+			return;
+		// sort member INDICES (not the members themselves), then move each member
+		// just once into its final position, skipping any duplicates
+		constexpr size_type small{ 64 };
+		size_type sx[small];
+		std::vector<size_type> vx;
+		auto ix{ sx };
+		if (n > small)
+			vx.resize(n), ix = vx.data();
+		for (size_type j = 0; j < n; ++j)
+			ix[j] = j;
+		if (n <= small)
+			// (simple insertion sort for small objects, with NO allocations)
+			for (size_type j = 1; j < n; ++j)
+				for (auto k = j; k > 0 && less(ix[k], ix[k - 1]); --k)
+					std::swap(ix[k], ix[k - 1]);
+		else
+			std::stable_sort(ix, ix + n, less);
+		container_type w(v.get_allocator());
+		w.reserve(n);
+		for (size_type j = 0; j < n; ++j)
+			if (w.empty() || Cmp{}(w.back().first, v[ix[j]].first))
+				w.push_back(std::move(v[ix[j]]));
+		v = std::move(w);
+	}
+
+	friend constexpr bool operator==(const flat_map& a, const flat_map& b) { return a.v == b.v; }
+	friend constexpr auto operator<=>(const flat_map& a, const flat_map& b) { return a.v <=> b.v; }
+
+private:
+	container_type v;
+};
+
+/*
+	ordered_map is another [mostly] drop-in replacement for std::map, but one that
+	keeps its members in INSERTION order... so a parsed object is stringified with
+	its members in exactly the order they appeared in the original JSON text.  The
+	members are a contiguous vector of key/value pairs, with lookups by key done
+	using a side "open addressing" hash index of member positions (for objects too
+	small to benefit, a simple linear search is used, and NO index is allocated).
+
+	As with std::map, inserting an already-present key does NOTHING (so "first key
+	wins"), and comparisons IGNORE member order: two objects having the same keys
+	and values are equal, while <=> compares members as if they were sorted by key
+	(just like std::map and rmj::flat_map).
+
+	Parsing (with lazy_numbers) and then stringifying gives BACK the original JSON
+	text, byte for byte, ONLY if that text is itself as to_string writes it, i.e.,
+	has NO whitespace between tokens, NO duplicate keys (as only the first is
+	kept), and strings escaped EXACTLY as to_string escapes them - just ", \ and
+	control chars, the latter as \b, \f, \n, \r, \t or [lower-case] \u00xx,
+	and non-ASCII chars as [lower-case] \uxxxx, or as UTF-8 if stringified with
+	pass_thru... otherwise, the text is "normalized" (see t0.cpp).
+
+	N.B. - keys must be viewable as std::string_views (as js_str certainly is),
+	and [as with std::map] are const when reached through an iterator.
+*/
+template<typename K, typename T, typename Hash = std::hash<std::string_view>, typename Alloc = std::allocator<std::pair<K, T>>>
+class ordered_map {
+public:
+	using key_type = K;
+	using mapped_type = T;
+	using value_type = std::pair<const K, T>;
+	using hasher = Hash;
+	using allocator_type = Alloc;
+	using size_type = size_t;
+	using container_type = std::vector<std::pair<K, T>, Alloc>;
+	using iterator = const_key_iterator<typename container_type::iterator, value_type>;
+	using const_iterator = const_key_iterator<typename container_type::const_iterator, const value_type>;
+
+	ordered_map() = default;
+	explicit ordered_map(const Alloc& a) : v(a), h(a) {}
+	ordered_map(std::initializer_list<value_type> il, const Alloc& a = Alloc()) : v(a), h(a) {
+		for (const auto& e : il)
+			insert(e);
+	}
+
+	constexpr auto get_allocator() const noexcept { return v.get_allocator(); }
+	constexpr iterator begin() noexcept { return iterator{ v.begin() }; }
+	constexpr const_iterator begin() const noexcept { return const_iterator{ v.begin() }; }
+	constexpr iterator end() noexcept { return iterator{ v.end() }; }
+	constexpr const_iterator end() const noexcept { return const_iterator{ v.end() }; }
+	constexpr const_iterator cbegin() const noexcept { return begin(); }
+	constexpr const_iterator cend() const noexcept { return end(); }
+	constexpr auto size() const noexcept { return v.size(); }
+	constexpr auto empty() const noexcept { return v.empty(); }
+	constexpr void clear() noexcept { v.clear(), h.clear(); }
+	constexpr void reserve(size_type n) { v.reserve(n); }
+
+	template<class Q> constexpr iterator find(const Q& k) { return begin() + locate(k); }
+	template<class Q> constexpr const_iterator find(const Q& k) const { return begin() + locate(k); }
+	template<class Q> constexpr bool contains(const Q& k) const { return locate(k) != v.size(); }
+	template<class Q> constexpr size_type count(const Q& k) const { return contains(k) ? 1 : 0; }
+	template<class Q> constexpr T& at(const Q& k) {
+		if (const auto i{ locate(k) }; i != v.size())
+			return v[i].second;
+		throw std::out_of_range("ordered_map::at: key not found");
+	}
+	template<class Q> constexpr const T& at(const Q& k) const {
+		if (const auto i{ locate(k) }; i != v.size())
+			return v[i].second;
+		throw std::out_of_range("ordered_map::at: key not found");
+	}
+	template<class Q> constexpr T& operator[](Q&& k) { return try_emplace(std::forward<Q>(k)).first->second; }
+
+	// (as with std::map, do NOTHING if the key is already present)
+	template<class Q, class... Args>
+	constexpr std::pair<iterator, bool> try_emplace(Q&& k, Args&&... args) {
+		if (const auto i{ locate(k) }; i != v.size())
+			return { begin() + i, false };
+		v.emplace_back(std::piecewise_construct,
+			std::forward_as_tuple(std::forward<Q>(k)), std::forward_as_tuple(std::forward<Args>(args)...));
+		if (!h.empty() && v.size() * 2 <= h.size())
+			place(v.size() - 1);
+		else if (v.size() > linear)
+			rehash();
+		return { end() - 1, true };
+	}
+	constexpr std::pair<iterator, bool> insert(const value_type& e) { return try_emplace(e.first, e.second); }
+	constexpr std::pair<iterator, bool> insert(value_type&& e) { return try_emplace(std::move(e.first), std::move(e.second)); }
+	template<class... Args>
+	constexpr std::pair<iterator, bool> emplace(Args&&... args) {
+		std::pair<K, T> e(std::forward<Args>(args)...);
+		return try_emplace(std::move(e.first), std::move(e.second));
+	}
+	// N.B. - erasing preserves the order of the remaining members, but is O(n)
+	constexpr iterator erase(const_iterator i) {
+		const auto j{ i - cbegin() };
+		v.erase(i.base());
+		rehash();
+		return begin() + j;
+	}
+	template<class Q>
+		requires (!std::convertible_to<const Q&, const_iterator>)
+	constexpr size_type erase(const Q& k) {
+		if (const auto i{ locate(k) }; i != v.size())
+			return erase(cbegin() + i), 1;
+		return 0;
+	}
+
+	friend constexpr bool operator==(const ordered_map& a, const ordered_map& b) {
+		if (a.size() != b.size())
+			return false;
+		for (const auto& [k, t] : a.v)
+			if (const auto i{ b.locate(k) }; i == b.size() || !(b.v[i].second == t))
+				return false;
+		return true;
+	}
+	friend constexpr std::weak_ordering operator<=>(const ordered_map& a, const ordered_map& b) {
+		const auto x{ a.by_key() }, y{ b.by_key() };
+		for (size_type i = 0; i < x.size() && i < y.size(); ++i) {
+			const auto& [k, t] { a.v[x[i]] };
+			const auto& [l, u] { b.v[y[i]] };
+			if (const auto c{ std::string_view{ k } <=> std::string_view{ l } }; c != 0)
+				return c;
+			if (t < u)
+				return std::weak_ordering::less;
+			if (u < t)
+				return std::weak_ordering::greater;
+		}
+		return x.size() <=> y.size();
+	}
+
+private:
+	// (objects up to this size are searched linearly, WITHOUT a hash index)
+	static constexpr size_type linear{ 8 };
+
+	// return the position of the member having key k... or size() if none
+	template<class Q> constexpr size_type locate(const Q& k) const {
+		const std::string_view s{ k };
+		if (h.empty()) {
+			for (size_type i = 0; i < v.size(); ++i)
+				if (std::string_view{ v[i].first } == s)
+					return i;
+			return v.size();
+		}
+		const auto mask{ h.size() - 1 };
+		for (auto i{ Hash{}(s) & mask }; h[i]; i = (i + 1) & mask)
+			if (std::string_view{ v[h[i] - 1].first } == s)
+				return h[i] - 1;
+		return v.size();
+	}
+	// index member at position j (each slot holds position + 1, or 0 if empty)
+	constexpr void place(size_type j) {
+		const auto mask{ h.size() - 1 };
+		auto i{ Hash{}(std::string_view{ v[j].first }) & mask };
+		while (h[i])
+			i = (i + 1) & mask;
+		h[i] = uint32_t(j + 1);
+	}
+	// (re)build the hash index, keeping the load factor at or below 1/2
+	constexpr void rehash() {
+		h.clear();
+		if (v.size() <= linear)
+			return;
+		h.resize(std::bit_ceil(v.size() * 4));
+		for (size_type j = 0; j < v.size(); ++j)
+			place(j);
+	}
+	// (member positions in key order, as used for 3-way comparisons)
+	constexpr auto by_key() const {
+		std::vector<size_type> x(v.size());
+		for (size_type j = 0; j < x.size(); ++j)
+			x[j] = j;
+		std::sort(x.begin(), x.end(), [this](size_type a, size_type b) {
+			return std::string_view{ v[a].first } < std::string_view{ v[b].first }; });
+		return x;
+	}
+
+	container_type v;
+	std::vector<uint32_t, typename std::allocator_traits<Alloc>::template rebind_alloc<uint32_t>> h;
+};
+
 // (make sure we use c++14 "is_transparent" comparators)
+#if defined(USE_ORDERED_MAP)
+template<typename K, typename T, typename Cmp = std::less<>>
+using map = ordered_map<K, T, std::hash<std::string_view>, js_alloc<std::pair<K, T>>>;
+#elif defined(USE_FLAT_MAP)
 template<typename K, typename T, typename Cmp = std::less<>>
-using map = std::map<K, T, Cmp>;
+using map = flat_map<K, T, Cmp, js_alloc<std::pair<K, T>>>;
+#else
+template<typename K, typename T, typename Cmp = std::less<>>
+using map = std::map<K, T, Cmp, js_alloc<std::pair<const K, T>>>;
+#endif
+
+/*
+	js_raw_num is a JSON number NOT [yet] converted, i.e., a view of its digits in
+	the original JSON text (see the parse_opts lazy_numbers option)... js_val
+	converts it only when asked for its value, and to_string reproduces the text
+	EXACTLY - so it may even hold more precision than a double (or js_int) can.
+
+	N.B. - ONLY parse creates js_raw_nums (of text it has checked), so that their
+	text is ALWAYS a valid JSON number... which, as NOTHING is cached, is converted
+	[again] on EVERY read of its value (so to read it often, convert it just once)
+*/
+class js_raw_num {
+	friend class js_val;
+
+	std::string_view t;
+
+	constexpr explicit js_raw_num(std::string_view t) noexcept : t(t) {}
+
+public:
+	constexpr std::string_view text() const noexcept { return t; }
+	constexpr auto operator<=>(const js_raw_num&) const = default;
+};
 
 /*
 	Define the JSON "value" type as a *recursive* variant by using the most
@@ -77,14 +568,20 @@ using js_val_base = rva::variant<
 	nullptr_t,
 	bool,
 	double,
-	std::string,
-	map<std::string, rva::self_t>,
-	std::vector<rva::self_t>>;
+	js_str,
+	map<js_str, rva::self_t>,
+	std::vector<rva::self_t, js_alloc<rva::self_t>>,
+	// (exact integers are ALSO JSON numbers, added last so as NOT to disturb
+	// the index of any other alternative)
+	std::int64_t,
+	// (... as are "lazy" numbers, see parse_opts)
+	js_raw_num>;
 
 // "convenience" typedefs for the non-literal js_val alternatives
-using js_obj = map<std::string, js_val_base>;
-using js_arr = std::vector<js_val_base>;
+using js_obj = map<js_str, js_val_base>;
+using js_arr = std::vector<js_val_base, js_alloc<js_val_base>>;
 using js_num = double; // (useful for any conversion / precision questions)
+using js_int = std::int64_t; // (JSON numbers having an EXACT integral value)
 
 // (internally used definitions not intended to appear in the rmj namespace)
 namespace detail {
@@ -225,20 +722,527 @@ namespace detail {
 		return t;
 	}
 
+	/*
+		find_string_special returns a pointer to the first char in [p, e) that may
+		need "special" handling in a JSON string, i.e., a '"', a '\\', any NON-ASCII
+		byte (part of a utf-8 multi-byte sequence) and - if Controls is true - any
+		"control" char (< 0x20)... everything BEFORE that may simply be copied.
+
+		When available, 32 (AVX2) or 16 (SSE2) chars are examined at a time, with a
+		portable 8-chars-at-a-time "SWAR" fallback, followed by a simple byte loop.
+	*/
+	template<bool Controls>
+	inline const char* find_string_special(const char* p, const char* e) noexcept {
+#if defined(RMJ_AVX2)
+		const auto q{ _mm256_set1_epi8('"') }, bs{ _mm256_set1_epi8('\\') };
+		for (; e - p >= 32; p += 32) {
+			const auto v{ _mm256_loadu_si256((const __m256i*)p) };
+			auto x{ _mm256_or_si256(_mm256_cmpeq_epi8(v, q), _mm256_cmpeq_epi8(v, bs)) };
+			if constexpr (Controls)
+				// (signed compare: non-ASCII bytes are "negative", so < 0x20 anyway)
+				x = _mm256_or_si256(x, _mm256_cmpgt_epi8(_mm256_set1_epi8(0x20), v));
+			if (const auto m{ unsigned(_mm256_movemask_epi8(_mm256_or_si256(x, v))) })
+				return p + std::countr_zero(m);
+		}
+#elif defined(RMJ_SSE2)
+		const auto q{ _mm_set1_epi8('"') }, bs{ _mm_set1_epi8('\\') };
+		for (; e - p >= 16; p += 16) {
+			const auto v{ _mm_loadu_si128((const __m128i*)p) };
+			auto x{ _mm_or_si128(_mm_cmpeq_epi8(v, q), _mm_cmpeq_epi8(v, bs)) };
+			if constexpr (Controls)
+				// (signed compare: non-ASCII bytes are "negative", so < 0x20 anyway)
+				x = _mm_or_si128(x, _mm_cmplt_epi8(v, _mm_set1_epi8(0x20)));
+			if (const auto m{ unsigned(_mm_movemask_epi8(_mm_or_si128(x, v))) })
+				return p + std::countr_zero(m);
+		}
+#endif
+		// (classic "has zero byte" bit-twiddling, applied 8 chars at a time)
+		constexpr uint64_t ones{ 0x0101010101010101 }, highs{ 0x8080808080808080 };
+		for (; e - p >= 8; p += 8) {
+			uint64_t v;
+			std::memcpy(&v, p, 8);
+			auto zero = [](uint64_t x) { return (x - ones) & ~x & highs; };
+			auto x{ zero(v ^ (ones * '"')) | zero(v ^ (ones * '\\')) | (v & highs) };
+			if constexpr (Controls)
+				x |= (v - ones * 0x20) & ~v & highs;
+			if (x)
+				break; // (let the byte loop below find out exactly WHICH char)
+		}
+		for (; p < e; ++p)
+			if (const auto c = (char8_t)*p; c == '"' || c == '\\' || c >= 0x80 || (Controls && c < 0x20))
+				return p;
+		return e;
+	}
+
 	// (Herb Sutter's [presumably] portable "trick" to make compilers shut up)
 	template<class T> void ignore(const T&) {}
 
+	/*
+		char_sink describes the output "sink" type(s) accepted by js_val::stringify,
+		which is where ALL RMj serialization actually takes place... std::string is
+		the canonical example, but anything supporting these two methods will do.
+	*/
+	template<class T>
+	concept char_sink = requires(T& t, const char* p, size_t n, char c) {
+		t.append(p, n);
+		t.push_back(c);
+	};
+
+	// a char_sink that keeps NOTHING, only noting if any char was "unescaped"
+	struct check_sink {
+		bool escaped{};
+		constexpr void append(const char*, size_t) noexcept {}
+		constexpr void push_back(char) noexcept { escaped = true; }
+	};
+
+	// adapt an output iterator (e.g., a std::format_context::iterator) to a sink
+	template<class OutIt>
+	struct iterator_sink {
+		OutIt out;
+		constexpr void append(const char* p, size_t n) { out = std::copy(p, p + n, out); }
+		constexpr void push_back(char c) { *out++ = c; }
+	};
+
+	/*
+		view_sink is a char_sink that avoids copying whenever it can... as long as
+		everything appended is a single contiguous run of [source] text, it simply
+		keeps a view of that text, and ONLY otherwise is the scratch buffer used.
+	*/
+	class view_sink {
+		const char* b{};
+		size_t n{};
+		std::string& t;
+		bool copied{};
+
+		void spill() {
+			if (!copied)
+				t.assign(b, n), copied = true;
+		}
+
+	public:
+		explicit view_sink(std::string& scratch) : t(scratch) {}
+		void append(const char* p, size_t k) {
+			if (copied || (n && p != b + n))
+				spill(), t.append(p, k);
+			else {
+				if (!n)
+					b = p;
+				n += k;
+			}
+		}
+		void push_back(char c) { spill(), t.push_back(c); }
+		std::string_view view() const noexcept { return copied ? std::string_view{ t } : std::string_view{ b, n }; }
+	};
+
+	/*
+		byte_source describes the input "source" type(s) accepted by js_val::decode
+		(the binary counterpart of parse)... read(p, n) must read EXACTLY n bytes
+		into p, returning false if it can't (i.e., the input ended too soon).
+	*/
+	template<class T>
+	concept byte_source = requires(T& t, char* p, size_t n) {
+		{ t.read(p, n) } -> std::convertible_to<bool>;
+	};
+
+	// a byte_source reading [and consuming] a string_view
+	struct view_source {
+		std::string_view s;
+		bool read(char* p, size_t n) noexcept {
+			if (n > s.size())
+				return false;
+			if (n)
+				std::memcpy(p, s.data(), n);
+			s.remove_prefix(n);
+			return true;
+		}
+	};
+#ifndef NO_STREAM
+	// ... or reading a std::istream (e.g., a std::ifstream opened in binary mode)
+	struct istream_source {
+		std::istream& is;
+		bool read(char* p, size_t n) { return bool(is.read(p, std::streamsize(n))); }
+	};
+#endif
+
+	// output external form of JSON "number"
+	template<char_sink Sink>
+	constexpr void stringify_num(Sink& o, double v) {
+		char b[32];
+		const auto [p, e] = std::to_chars(b, b + std::size(b), v);
+		o.append(b, size_t(p - b));
+	}
+	// (... as well as that of an exact integer, NOT needing any float formatting)
+	template<char_sink Sink>
+	constexpr void stringify_num(Sink& o, std::int64_t v) {
+		char b[24];
+		const auto [p, e] = std::to_chars(b, b + std::size(b), v);
+		o.append(b, size_t(p - b));
+	}
+
+	// compare an exact integer with a double, EXACTLY (i.e., not by converting
+	// the integer to a double, which may well round it)
+	constexpr std::partial_ordering compare_num(std::int64_t i, double d) noexcept {
+		if (d != d)
+			return std::partial_ordering::unordered;
+		if (d >= 0x1p63)
+			return std::partial_ordering::less;
+		if (d < -0x1p63)
+			return std::partial_ordering::greater;
+		// (d is now in range, so truncating it to an integer is well-defined...
+		// and any fraction it has is exactly d minus that integer)
+		if (const auto t{ std::int64_t(d) }; i != t)
+			return i <=> t;
+		else
+			return 0.0 <=> d - double(t);
+	}
+
+	// output external form of JSON "string" (see js_val::to_string for details)
+	// N.B. - runs of chars needing NO escapes are found by find_string_special, and
+	// so [when available] using SIMD... except in a constant evaluation, of course
+	template<char_sink Sink>
+	constexpr void stringify_string(Sink& o, std::string_view v, bool pass_thru) {
+		auto utf16 = [&o](char16_t c) {
+			constexpr char hex[]{ "0123456789abcdef" };
+			const char b[]{ '\\', 'u', hex[c >> 12], hex[c >> 8 & 15], hex[c >> 4 & 15], hex[c & 15] };
+			o.append(b, std::size(b));
+		};
+		size_t co{}, run{}; // (current offset, start of "clean" run of chars)
+		// (flush any pending run of chars NOT requiring escapes in a single append)
+		auto flush = [&]() { if (run < co) o.append(v.data() + run, co - run); };
+		o.push_back('"');
+		while (co < v.size()) {
+			// (skip ALL of any run of chars needing NO escapes in one step)
+			if (!std::is_constant_evaluated())
+				if (co = size_t(find_string_special<true>(v.data() + co, v.data() + v.size()) - v.data()); co == v.size())
+					break;
+			if (auto n = sizeOfUTF8CodeUnits((char8_t)v[co]); n <= 1) {
+				if (!n)
+					throw std::runtime_error("Bad stringify (STRING: invalid utf-8 sequence)"s);
+				if (const auto c = (char8_t)v[co]; c >= 0x20 && c != 0x22 && c != 0x5c) {
+					++co;
+					continue;
+				}
+				flush();
+				switch (const auto c = (char8_t)v[co++]; c) {
+				case 0x08: o.append("\\b", 2); break;
+				case 0x09: o.append("\\t", 2); break;
+				case 0x0a: o.append("\\n", 2); break;
+				case 0x0c: o.append("\\f", 2); break;
+				case 0x0d: o.append("\\r", 2); break;
+				case 0x22: o.append("\\\"", 2); break;
+				case 0x5c: o.append("\\\\", 2); break;
+				default: utf16(c); break;
+				}
+				run = co;
+			} else if (co + n > v.size())
+				throw std::runtime_error("Bad stringify (STRING: invalid utf-8 sequence)"s);
+			else if (!pass_thru) {
+				flush();
+				// (handle utf-16 Basic Multilingual Plane as well as surrogate pairs)
+				codePointToUTF16(codePointFromUTF8(v.data() + co), utf16);
+				run = co += n;
+			} else
+				co += n;
+		}
+		flush();
+		o.push_back('"');
+	}
+
+	// is s valid UTF-8? (checked just as parse checks the chars of JSON strings)
+	constexpr bool is_utf8(std::string_view s) noexcept {
+		for (size_t i{}; i < s.size(); ) {
+			const auto n = sizeOfUTF8CodeUnits((char8_t)s[i]);
+			if (!n || i + n > s.size())
+				return false;
+			for (size_t j = 1; j < n; ++j)
+				if (((char8_t)s[i + j] & 0b11000000) != 0b10000000)
+					return false;
+			i += n;
+		}
+		return true;
+	}
+
+	// combine hash h with v (N.B. - the "mixing" is from splitmix64, so that even
+	// similar values, e.g., small integers, are spread well over ALL the bits)
+	constexpr size_t hash_mix(uint64_t h, uint64_t v) noexcept {
+		auto x{ h * 0x9e3779b97f4a7c15 + v };
+		x = (x ^ x >> 30) * 0xbf58476d1ce4e5b9;
+		x = (x ^ x >> 27) * 0x94d049bb133111eb;
+		return size_t(x ^ x >> 31);
+	}
+
+	// does map type support "bulk" construction (i.e., members appended UNsorted,
+	// then sorted and "deduped" just once), e.g., rmj::flat_map?
+	template<class M>
+	concept bulk_map = requires(M& m) { m.sort_unique(); };
+
+	// add a [parsed] member to an object, keeping the FIRST of any duplicate keys,
+	// and returning a pointer to the added value (or nullptr if a duplicate)
+	// N.B. - a "bulk" map is far happier being sorted just ONCE, in end_members
+	// (so until then, ANY member is "added", and a duplicate is removed later)
+	template<class M, class K, class V>
+	constexpr typename M::mapped_type* add_member(M& m, K&& k, V&& v) {
+		if constexpr (bulk_map<M>) {
+			m.append_unsorted(std::forward<K>(k), std::forward<V>(v));
+			return &(m.end() - 1)->second;
+		} else {
+			const auto [i, added] = m.try_emplace(std::forward<K>(k), std::forward<V>(v));
+			return added ? &i->second : nullptr;
+		}
+	}
+	template<class M>
+	constexpr void end_members(M& m) {
+		if constexpr (bulk_map<M>)
+			m.sort_unique();
+	}
+
 	// allow *assignment* of actual *numbers* (which means NO nullptrs or bools)
 	template <class T>
 	concept numeric =
 	(std::integral<T> || std::floating_point<T>) &&
 	!(std::same_as<T, nullptr_t> || std::same_as<T, bool>);
+
+	// the "event" methods called by [SAX-style] js_val::parse (see sax_handler)
+	template<class H>
+	concept sax_events = requires(H& h, std::string_view s) {
+		h.start_object();
+		h.key(s);
+		h.end_object();
+		h.start_array();
+		h.end_array();
+		h.value(nullptr);
+		h.value(true);
+		h.value(1.0);
+		h.value(s);
+	};
+
+	// (a "probe" argument converting ONLY to exactly T, NOT to anything else)
+	template<class T>
+	struct exactly {
+		template<class U>
+			requires std::same_as<U, T>
+		operator U() const noexcept;
+	};
+	// [optional] event for exact integers, a handler having value(js_int)... any
+	// handler WITHOUT one is given integers [converted] as value(double) events
+	template<class H>
+	concept sax_int_events = requires(H& h) { h.value(exactly<std::int64_t>{}); };
+	template<class H>
+	void number_event(H& h, std::int64_t i) {
+		if constexpr (sax_int_events<H>)
+			h.value(i);
+		else
+			h.value(double(i));
+	}
+	template<class H>
+	void number_event(H& h, double d) { h.value(d); }
 }
 
+/*
+	mapped_file makes the ENTIRE contents of a file available as a string_view,
+	by "memory-mapping" it (read-only)... so that, e.g., js_val::parse_file can
+	parse JSON text directly from the file, WITHOUT first reading (copying) all
+	of it into a string - the OS pages it in as it is parsed, and [on POSIX] is
+	advised that this will be sequential access.
+
+	Failure to open or map the file throws a std::system_error, whose what() text
+	includes the failing operation and the path of the file.
+
+	Once any sequential pass is done, advise_random then tells the OS [on POSIX]
+	that the rest of its access will be random (so it stops reading ahead).
+
+	N.B. - if NO_MMAP is defined, the file is simply read into a std::string.
+*/
+class mapped_file {
+	const char* p{};
+	size_t n{};
+#if defined(NO_MMAP)
+	std::string s;
+#elif defined(_WIN32)
+	HANDLE h{ INVALID_HANDLE_VALUE }, m{};
+#endif
+
+	static std::error_code last_error() noexcept {
+#if defined(_WIN32) && !defined(NO_MMAP)
+		return { int(::GetLastError()), std::system_category() };
+#else
+		return { errno, std::generic_category() };
+#endif
+	}
+	[[noreturn]] static void fail(std::error_code e, const char* what, const std::filesystem::path& path) {
+		throw std::system_error(e, "rmj::mapped_file: "s + what + " " + path.string());
+	}
+
+public:
+	explicit mapped_file(const std::filesystem::path& path) {
+#if defined(NO_MMAP)
+		std::ifstream f(path, std::ios::binary);
+		if (!f)
+			fail(last_error(), "unable to open", path);
+		std::error_code e;
+		const auto z{ std::filesystem::file_size(path, e) };
+		if (e)
+			fail(e, "unable to size", path);
+		s.resize(size_t(z));
+		if (!f.read(s.data(), std::streamsize(s.size())))
+			fail(last_error(), "unable to read", path);
+		p = s.data(), n = s.size();
+#elif defined(_WIN32)
+		h = ::CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+			OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		// (N.B. - capture any error BEFORE cleaning up, which may well change it)
+		auto bail = [&](const char* what, std::error_code e = last_error()) {
+			close();
+			fail(e, what, path);
+		};
+		if (h == INVALID_HANDLE_VALUE)
+			fail(last_error(), "unable to open", path);
+		LARGE_INTEGER z;
+		if (!::GetFileSizeEx(h, &z))
+			bail("unable to size");
+		if (uint64_t(z.QuadPart) > SIZE_MAX)
+			bail("unable to map", { ERROR_FILE_TOO_LARGE, std::system_category() });
+		// (an EMPTY file can't be mapped, but then there is nothing to map)
+		if (n = size_t(z.QuadPart); n) {
+			if (m = ::CreateFileMappingW(h, nullptr, PAGE_READONLY, 0, 0, nullptr); !m)
+				bail("unable to map");
+			if (p = (const char*)::MapViewOfFile(m, FILE_MAP_READ, 0, 0, 0); !p)
+				bail("unable to map");
+		}
+#else
+		const auto fd{ ::open(path.c_str(), O_RDONLY | O_CLOEXEC) };
+		// (N.B. - capture any error BEFORE cleaning up, which may well change it)
+		auto bail = [&](const char* what, std::error_code e = last_error()) {
+			::close(fd);
+			fail(e, what, path);
+		};
+		if (fd < 0)
+			fail(last_error(), "unable to open", path);
+		struct stat st;
+		if (::fstat(fd, &st) < 0)
+			bail("unable to size");
+		if (uint64_t(st.st_size) > SIZE_MAX)
+			bail("unable to map", std::make_error_code(std::errc::file_too_large));
+		// (an EMPTY file can't be mapped, but then there is nothing to map)
+		if (n = size_t(st.st_size); n) {
+			const auto a{ ::mmap(nullptr, n, PROT_READ, MAP_PRIVATE, fd, 0) };
+			if (a == MAP_FAILED)
+				bail("unable to map");
+			::madvise(a, n, MADV_SEQUENTIAL);
+			p = (const char*)a;
+		}
+		// (N.B. - the mapping remains valid after the file is closed)
+		::close(fd);
+#endif
+	}
+	mapped_file(const mapped_file&) = delete;
+	mapped_file& operator=(const mapped_file&) = delete;
+	~mapped_file() { close(); }
+
+	inline std::string_view view() const noexcept { return { p, n }; }
+	inline size_t size() const noexcept { return n; }
+	void advise_random() const noexcept {
+#if !defined(NO_MMAP) && !defined(_WIN32)
+		if (p)
+			::madvise(const_cast<char*>(p), n, MADV_RANDOM);
+#endif
+	}
+
+private:
+	void close() noexcept {
+#if defined(NO_MMAP)
+		s.clear();
+#elif defined(_WIN32)
+		if (p)
+			::UnmapViewOfFile(p);
+		if (m)
+			::CloseHandle(m);
+		if (h != INVALID_HANDLE_VALUE)
+			::CloseHandle(h);
+		h = INVALID_HANDLE_VALUE, m = nullptr;
+#else
+		if (p)
+			::munmap((void*)p, n);
+#endif
+		p = nullptr, n = 0;
+	}
+};
+
+// the binary "interchange" formats supported by js_val::encode and decode
+enum class binary_format {
+	cbor, // (RFC 8949)
+	msgpack // (MessagePack)
+};
+
+/*
+	Options controlling the behavior of js_val::parse... just use C++20 designated
+	initializers to select the one(s) wanted, e.g.,
+
+	js_val::parse(text, { .lazy_numbers = true })
+*/
+struct parse_opts {
+	// number of threads used by parse_lines (0 = std::thread::hardware_concurrency)
+	unsigned threads{};
+	// maximum nesting of objects and arrays (0 = unlimited)... deeper JSON text is
+	// rejected as a parse error, so that a js_val is never deeper than the stack
+	// of whatever thread works with it (destroying, serializing, etc.) can handle
+	unsigned max_depth{ 1024 };
+	// keep numbers as js_raw_nums, i.e., views of their [checked] text, which are
+	// converted only if their value is asked for... and which to_string outputs
+	// unchanged, so a js_val parsed, [partly] changed and then re-serialized is
+	// NOT burdened with converting numbers to doubles and back again
+	// N.B. - the JSON text MUST then outlive the js_val (so parse_file ignores this)
+	bool lazy_numbers{};
+	// (js_compact_doc ONLY) parse "in situ", i.e., keep each string or key with NO
+	// escapes as a view of the JSON text, rather than copying it... ONLY strings
+	// WITH escapes then need storage of their own
+	// N.B. - the JSON text MUST then outlive the js_compact_doc
+	bool in_situ{};
+#ifdef USE_PMR
+	// memory resource supplying ALL storage for the resulting js_val tree, i.e.,
+	// every node, string and container (nullptr = std::pmr default resource)
+	// N.B. - this MUST outlive the js_val (but see js_doc, which handles this)
+	// ... and when used by parse_lines with multiple threads, must be thread-safe
+	// (e.g., a std::pmr::synchronized_pool_resource)
+	std::pmr::memory_resource* mr{};
+#endif
+};
+
+/*
+	sax_handler is a convenient [public] base for "event" handlers passed to the
+	streaming (aka SAX-style) form of js_val::parse... all of its event methods
+	do nothing, so a derived handler need only supply the events it cares about.
+
+	N.B. - a derived handler defining ANY value() method hides ALL of the below,
+	so add a "using sax_handler::value;" to it to keep the rest of them.
+*/
+struct sax_handler {
+	void start_object() {}
+	void key(std::string_view) {}
+	void end_object() {}
+	void start_array() {}
+	void end_array() {}
+	void value(nullptr_t) {}
+	void value(bool) {}
+	void value(double) {}
+	void value(std::string_view) {}
+};
+
+template<detail::sax_events Handler>
+class push_parser;
+class js_lazy_doc;
+class js_lazy;
+
 class js_val : public js_val_base {
+	// (push_parser and js_lazy_doc share our private parse states and lexer)
+	template<detail::sax_events Handler>
+	friend class push_parser;
+	friend class js_lazy_doc;
+	friend class js_lazy;
+
 	// collections of derived js_val forms, giving access to public methods
-	using js_obj_ext = map<std::string, js_val>;
-	using js_arr_ext = std::vector<js_val>;
+	using js_obj_ext = map<js_str, js_val>;
+	using js_arr_ext = std::vector<js_val, js_alloc<js_val>>;
 
 public:
 	// various ctors, copying, "converting" and otherwise
@@ -251,23 +1255,49 @@ public:
 	constexpr js_val(const nullptr_t& v) noexcept { get_base() = v; }
 	constexpr js_val(const bool& v) noexcept { get_base() = v; }
 	// coerce ANY "numeric" value (see detail::numeric concept) to underlying
-	// JSON/js_val numeric type of [IEEE 754] double
-	constexpr js_val(const detail::numeric auto& v) noexcept { get_base() = double(v); }
+	// JSON/js_val numeric type of [IEEE 754] double... OR, for integral values,
+	// to an exact 64-bit integer (unless an unsigned value is too large for one)
+	template<detail::numeric T>
+	constexpr js_val(const T& v) noexcept {
+		if constexpr (std::floating_point<T>)
+			get_base() = double(v);
+		else if constexpr (std::unsigned_integral<T> && sizeof(T) >= sizeof(js_int))
+			v > T(INT64_MAX) ? (get_base() = double(v)) : (get_base() = js_int(v));
+		else
+			get_base() = js_int(v);
+	}
 	// accept std::strings and string literals...
+#ifdef USE_PMR
+	// (N.B. - std::pmr allocators are NOT constexpr, so neither are these ctors)
+	inline js_val(const js_str& v) { get_base() = v; }
+	inline js_val(js_str&& v) noexcept { get_base() = std::move(v); }
+	inline js_val(const std::string& v) { get_base() = js_str{ v }; }
+	// ... but also accept std::string_views...
+	inline js_val(const std::string_view& v) { get_base() = js_str{ v }; }
+	// ... and "classic" NUL-terminated strings
+	inline js_val(const char* v) { get_base() = js_str{ v }; }
+#else
 	constexpr js_val(const std::string& v) { get_base() = v; }
-	constexpr js_val(std::string&& v) noexcept { get_base() = v; }
+	constexpr js_val(std::string&& v) noexcept { get_base() = std::move(v); }
 	// ... but also accept std::string_views...
 	constexpr js_val(const std::string_view& v) { get_base() = std::string{ v }; }
 	// ... and "classic" NUL-terminated strings
 	constexpr js_val(const char* v) { get_base() = std::string{ v }; }
+#endif
 	constexpr js_val(const js_obj& v) { get_base() = v; }
+	constexpr js_val(js_obj&& v) noexcept { get_base() = std::move(v); }
 	constexpr js_val(const js_arr& v) { get_base() = v; }
+	constexpr js_val(js_arr&& v) noexcept { get_base() = std::move(v); }
+	constexpr js_val(const js_raw_num& v) noexcept { get_base() = v; }
 
 	// query the current type held in our variant / "sum type"
 	constexpr auto is_null() const noexcept { return std::holds_alternative<nullptr_t>(get_base()); }
 	constexpr auto is_bool() const noexcept { return std::holds_alternative<bool>(get_base()); }
-	constexpr auto is_num() const noexcept { return std::holds_alternative<double>(get_base()); }
-	constexpr auto is_string() const noexcept { return std::holds_alternative<std::string>(get_base()); }
+	// N.B. - is_num is true for ALL numeric alternatives, is_int ONLY for integers
+	// (including a js_raw_num whose text is that of an integer fitting a js_int)
+	constexpr auto is_num() const noexcept { return std::holds_alternative<double>(get_base()) || std::holds_alternative<js_int>(get_base()) || is_raw(); }
+	constexpr bool is_int() const noexcept { return std::holds_alternative<js_int>(get_base()) || (is_raw() && raw_number().is_int()); }
+	constexpr auto is_string() const noexcept { return std::holds_alternative<js_str>(get_base()); }
 	constexpr auto is_obj() const noexcept { return std::holds_alternative<js_obj>(get_base()); }
 	constexpr auto is_arr() const noexcept { return std::holds_alternative<js_arr>(get_base()); }
 
@@ -275,20 +1305,48 @@ public:
 	constexpr const auto& as_null() const { return std::get<nullptr_t>(get_base()); }
 	constexpr const auto& as_bool() const { return std::get<bool>(get_base()); }
 	constexpr auto& as_bool() { return std::get<bool>(get_base()); }
-	constexpr const auto& as_num() const { return std::get<double>(get_base()); }
-	constexpr auto& as_num() { return std::get<double>(get_base()); }
-	constexpr const auto& as_string() const { return std::get<std::string>(get_base()); }
-	constexpr auto& as_string() { return std::get<std::string>(get_base()); }
-	/*inline const auto& as_obj() const { return (js_obj_ext&)std::get<js_obj>(get_base()); }*/
-	inline auto& as_obj() const { return (js_obj_ext&)std::get<js_obj>(get_base()); }
+	// (an integer or js_raw_num is converted to double, and a js_raw_num to js_int,
+	// returned BY VALUE... so that reading a number NEVER changes, nor loses the
+	// precision of, the js_val - a js_raw_num thus converting on EVERY read)
+	// N.B. - so, unlike earlier versions, there is NO double& as_num() to assign
+	// through... instead assign a new value, e.g., v = js_val{ v.as_num() + 1 }
+	constexpr double as_num() const {
+		if (is_raw()) {
+			const auto n{ raw_number() };
+			return n.as_num();
+		}
+		if (const auto i{ std::get_if<js_int>(&get_base()) })
+			return double(*i);
+		return std::get<double>(get_base());
+	}
+	constexpr js_int as_int() const {
+		if (is_raw()) {
+			const auto n{ raw_number() };
+			return n.as_int();
+		}
+		return std::get<js_int>(get_base());
+	}
+	constexpr const auto& as_string() const { return std::get<js_str>(get_base()); }
+	constexpr auto& as_string() { return std::get<js_str>(get_base()); }
+	inline const auto& as_obj() const { return (const js_obj_ext&)std::get<js_obj>(get_base()); }
+	inline auto& as_obj() { return (js_obj_ext&)std::get<js_obj>(get_base()); }
 	inline const auto& as_arr() const { return (js_arr_ext&)std::get<js_arr>(get_base()); }
 	inline auto& as_arr() { return (js_arr_ext&)std::get<js_arr>(get_base()); }
 
 	// "convenience" operators for element access in js_obj and js_arr collections
 	// N.B. - these will FORCE the map/vector alternatives respectively, be aware!
-	inline const auto& operator[](const std::string& s) const { return as_obj()[s]; }
+	// ... while those of a CONST js_val NEVER add a member, instead throwing
+	// std::out_of_range for a key NOT present
+#ifdef USE_PMR
+	inline const js_val& operator[](const js_str& s) const { return member(s); }
+	inline auto& operator[](const js_str& s) { return as_obj()[s]; }
+	inline const js_val& operator[](const std::string& s) const { return member(s); }
+	inline auto& operator[](const std::string& s) { return as_obj()[js_str{ s }]; }
+#else
+	inline const js_val& operator[](const std::string& s) const { return member(s); }
 	inline auto& operator[](const std::string& s) { return as_obj()[s]; }
-	inline const auto& operator[](const char* s) const { return as_obj()[s]; }
+#endif
+	inline const js_val& operator[](const char* s) const { return member(s); }
 	inline auto& operator[](const char* s) { return as_obj()[s]; }
 	constexpr const auto& operator[](std::integral auto i) const { return as_arr()[i]; }
 	constexpr auto& operator[](std::integral auto i) { return as_arr()[i]; }
@@ -326,18 +1384,20 @@ public:
 			return to_int(std::strong_ordering::less);
 		if (u.valueless_by_exception())
 			return to_int(std::strong_ordering::greater);
-		if (t.index() != u.index())
-			return to_int(t.index() <=> u.index());
+		if (rank(t) != rank(u))
+			return to_int(rank(t) <=> rank(u));
 		switch (t.index()) {
 		case 0: // nullptr_t
 			return to_int(std::strong_ordering::equal);
 		case 1: // bool
 			return to_int(get<1>(t) <=> get<1>(u));
 		case 2: // double
-			return to_int(get<2>(t) <=> get<2>(u));
-		case 3: // std::string
+		case 6: // js_int
+		case 7: // js_raw_num
+			return to_int(compare_num(t, u));
+		case 3: // js_str
 			return to_int(get<3>(t) <=> get<3>(u));
-		case 4: // map<std::string, js_val>
+		case 4: // map<js_str, js_val>
 			return to_int((const js_obj_ext&)get<4>(t) <=> (const js_obj_ext&)get<4>(u));
 		case 5: // std::vector<js_val>>
 			return to_int((const js_arr_ext&)get<5>(t) <=> (const js_arr_ext&)get<5>(u));
@@ -350,7 +1410,7 @@ public:
 		const auto& t{ *this };
 		if (t.valueless_by_exception() || u.valueless_by_exception())
 			return t.valueless_by_exception() && u.valueless_by_exception();
-		if (t.index() != u.index())
+		if (rank(t) != rank(u))
 			return false;
 		switch (t.index()) {
 		case 0: // nullptr_t
@@ -358,19 +1418,95 @@ public:
 		case 1: // bool
 			return get<1>(t) == get<1>(u);
 		case 2: // double
-			return get<2>(t) == get<2>(u);
-		case 3: // std::string
+		case 6: // js_int
+		case 7: // js_raw_num
+			return compare_num(t, u) == 0;
+		case 3: // js_str
 			return get<3>(t) == get<3>(u);
-		case 4: // map<std::string, js_val>
-			return get<4>(t) == get<4>(u);
+		case 4: // map<js_str, js_val>
+			return (const js_obj_ext&)get<4>(t) == (const js_obj_ext&)get<4>(u);
 		case 5: // std::vector<js_val>>
-			return get<5>(t) == get<5>(u);
+			return (const js_arr_ext&)get<5>(t) == (const js_arr_ext&)get<5>(u);
 		default:
 			return false; // (NOT expected)
 		}
 	}
 
+	/*
+		A "deep" hash of the ENTIRE value, consistent with operator== above... so
+		ALL numeric alternatives hash by value (e.g., 1, 1.0 and a js_raw_num "1e0"
+		hash alike), array elements are hashed in order, and object members in ANY
+		order (as, with USE_ORDERED_MAP, objects are equal regardless of order).
+
+		N.B. - this visits EVERY value in the tree, so to hash [or compare] a value
+		many times, see js_hashed, which computes it just once
+	*/
+	size_t hash() const noexcept {
+		using detail::hash_mix;
+		switch (index()) {
+		case 1: // bool
+			return hash_mix(1, get<1>(*this));
+		case 2: { // double
+			// (an integral double hashes as the js_int it's equal to, if any... and
+			// N.B. - this includes -0.0, which is equal to 0)
+			const auto d{ get<2>(*this) };
+			if (d >= -0x1p63 && d < 0x1p63 && d == std::trunc(d))
+				return hash_mix(2, uint64_t(js_int(d)));
+			return hash_mix(3, std::bit_cast<uint64_t>(d));
+		}
+		case 6: // js_int
+			return hash_mix(2, uint64_t(get<6>(*this)));
+		case 7: // js_raw_num
+			return raw_number().hash();
+		case 3: // js_str
+			return hash_mix(4, std::hash<std::string_view>{}(get<3>(*this)));
+		case 4: { // map<js_str, js_val>
+			// (members are hashed independently, then combined in an order-free way)
+			uint64_t h{};
+			for (const auto& [key, val] : as_obj())
+				h += hash_mix(std::hash<std::string_view>{}(key), val.hash());
+			return hash_mix(5, h);
+		}
+		case 5: { // std::vector<js_val>
+			auto h{ hash_mix(6, as_arr().size()) };
+			for (const auto& e : as_arr())
+				h = hash_mix(h, e.hash());
+			return h;
+		}
+		default: // (nullptr_t)
+			return hash_mix(0, 0);
+		}
+	}
+
 private:
+	// (the member of [const] object having key k, which MUST be present)
+	const js_val& member(std::string_view k) const {
+		const auto& m{ as_obj() };
+		if (const auto i{ m.find(k) }; i != m.end())
+			return i->second;
+		throw std::out_of_range("js_val: key NOT found");
+	}
+
+	// (is this a js_raw_num, i.e., a "lazy" number?)
+	constexpr bool is_raw() const noexcept { return std::holds_alternative<js_raw_num>(get_base()); }
+
+	// (ALL numeric alternatives compare as the one JSON "number" type, which is
+	// ordered just as double, i.e., before js_str... and compare numerically)
+	static constexpr size_t rank(const js_val& v) noexcept { return v.index() >= 6 ? 2 : v.index(); }
+	static constexpr std::partial_ordering compare_num(const js_val& t, const js_val& u) noexcept {
+		if (t.is_raw())
+			return compare_num(t.raw_number(), u);
+		if (u.is_raw())
+			return compare_num(t, u.raw_number());
+		if (t.is_int() && u.is_int())
+			return t.as_int() <=> u.as_int();
+		if (t.is_int())
+			return detail::compare_num(t.as_int(), get<2>(u));
+		if (u.is_int())
+			return 0 <=> detail::compare_num(u.as_int(), get<2>(t));
+		return get<2>(t) <=> get<2>(u);
+	}
+
 	// defs supporting the implementation of RMj's parse() and to_string()...
 	enum class parse_state { free, in_number, in_keyword, in_string, in_object,
 		obj_colon, end_object, in_array, end_array, more_items, eod, illegal };
@@ -378,214 +1514,154 @@ private:
 	using val_or_state = std::variant<js_val, parse_state>;
 
 	// ... including the below riffs on "is" and "as" used above...
-	constexpr static auto has_state(auto v) noexcept { return std::holds_alternative<parse_state>(v); }
-	constexpr static auto state(auto v) { return std::get<parse_state>(v); }
+	// N.B. - these are all by REFERENCE, as parsed values are NEVER to be copied
+	constexpr static auto has_state(const val_or_state& v) noexcept { return std::holds_alternative<parse_state>(v); }
+	constexpr static auto state(const val_or_state& v) { return std::get<parse_state>(v); }
 
-	constexpr static auto has_val(auto v) noexcept { return std::holds_alternative<js_val>(v); }
-	constexpr static auto val(auto v) { return std::get<js_val>(v); }
+	constexpr static auto has_val(const val_or_state& v) noexcept { return std::holds_alternative<js_val>(v); }
+	constexpr static const auto& val(const val_or_state& v) { return std::get<js_val>(v); }
+	// (and finally, "steal" the parsed value to MOVE it to its final location)
+	constexpr static auto&& take(val_or_state& v) { return std::get<js_val>(std::move(v)); }
 
 	// ... and the mysterious and magical "overload" template for std::visit()
 	template<class... Ts> struct overload : Ts... { using Ts::operator()...; };
 
-public:
 	/*
-		Create an external string representation that is presumably valid RFC 8259
-		JSON text... the chances of this being the case are MUCH higher if the parsed
-		[internal] representation was itself created by parsing a valid RFC 8259 doc.
+		lexer is the JSON "tokenizer" shared by BOTH forms of parse()... it tracks
+		the current offset in the source text, classifies the next token by its
+		first char, and then reads any "value" token (string, number, or keyword)
+		when asked to.  Structural chars are consumed by the parsers themselves (++co).
 
-		A special note on anyone doing "round trip" testing: while parsing the UTF-8
-		input, if any UTF-16 "escaped" characters are seen, they will be converted to
-		their utf-8 encoding forms... this applies to both Basic Multilingual Plane
-		characters as well as any utf-16 "surrogate pairs".  This means that utf-16
-		"escaped" characters that were present prior to parsing will, on output by
-		rmj::to_string, appear as their EXACTLY EQUIVALENT utf-8 forms... which MAY
-		include some "control characters" (U+0000 - U+001F) represented as "\u00nn".
+		N.B. - push_parser uses ONLY the "value" token readers, on a single token.
+	*/
+	struct lexer {
+		std::string_view src;
+		size_t co{}; // ("current offset")
+		size_t base{}; // (offset of src in the "whole" JSON text, for exceptions)
 
-		For the "official" v1 release, the above is still true - but NOT as default
-		behavior.  The default is to output any non-ASCII and "control" characters
-		using JSON "escape" sequences... these are fully compatible and equivalent,
-		and defined in the JSON standard referenced above - but always printable.
-		To get the full "UNICODE-encoded-as-UTF-8" behavior for string output, just
-		call the public to_string fn with a bool 'true' parameter.
+		// lex a single [complete] token, found at offset base in the JSON text
+		lexer(std::string_view src, size_t base) noexcept : src(src), base(base) {}
+		lexer(std::string_view src, const parse_opts&) : src(src) {
+			// Detect and IGNORE utf-8 BOM at beginning of JSON text... (not reversible)
+			if (src.size() >= 3 &&
+				(char8_t)src[0] == 0xEF &&
+				(char8_t)src[1] == 0xBB &&
+				(char8_t)src[2] == 0xBF)
+				co += 3;
+		}
 
-		An important note on both to_string and parse (below) is that they are based
-		on the C++ library functions std::to_chars and std::from_chars... while this
-		is a Good Thing(tm) - in that "round trips" of JSON numbers (recall these are
-		represented by IEEE 754 64-bit floating point numbers, aka "doubles") will be
-		GUARANTEED to be symmetric - in that numeric values output by RMj will always
-		be a) readable by RMj, and b) they will result in the SAME internal numeric
-		value.  However, what may not match is attempting to compare these displayed
-		values with those output by other methods, such as the conversions performed
-		when outputting (and then inputting) doubles when using the C++ library "std"
-		stream input and output operations.
-
-		As an additional note on "round trips", any JSON text that included a BOM at
-		the beginning was politely accepted, after IGNORING said BOM... and under no
-		circumstances is any attempt made to remember this and include it in the new
-		version of the JSON text produced by to_string, as this would be in violation
-		of RFC 8259 - and a Bad Idea(tm) in general.
-	*/
-	constexpr std::string to_string(bool pass_thru = false) const {
-		using namespace detail;
-		// return external form of JSON "string"
-		auto string_of_string = [&](std::string_view v) {
-			size_t co{};
-			std::string o;
-			auto utf16 = [&o](char16_t c) {
-				char b[]{ '\\', 'u', '0', '0', '0', '0' };
-				const auto s =
-					c < 0x0010 ? 5 :
-					c < 0x0100 ? 4 :
-					c < 0x1000 ? 3 : 2;
-				ignore(std::to_chars(b + s, b + std::size(b), c, 16));
-				o.append(b, std::size(b));
-			};
-			o.reserve(256);
-			o.push_back('"');
-			while (co < v.size())
-				if (auto n = sizeOfUTF8CodeUnits((char8_t)v[co]); n <= 1) {
-					if (!n)
-						throw std::runtime_error("Bad stringify (STRING: invalid utf-8 sequence)"s);
-					switch (const auto c = (char8_t)v[co++]; c) {
-					case 0x08: o.append("\\b"sv); break;
-					case 0x09: o.append("\\t"sv); break;
-					case 0x0a: o.append("\\n"sv); break;
-					case 0x0c: o.append("\\f"sv); break;
-					case 0x0d: o.append("\\r"sv); break;
-					case 0x22: o.append("\\\""sv); break;
-					case 0x5c: o.append("\\\\"sv); break;
-					default:
-						if (c < 0x20)
-							utf16(c);
-						else
-							o.push_back(c);
-						break;
-					}
-				} else if (!pass_thru) {
-					// (handle utf-16 Basic Multilingual Plane as well as surrogate pairs)
-					codePointToUTF16(codePointFromUTF8(v.data() + co), utf16);
-					co += n;
-				} else
-					while (n--)
-						o.push_back(v[co++]);
-			o.push_back('"');
-			return o;
-		};
-		// return external form of JSON "object"
-		auto string_of_obj = [&](const auto& v) {
-			std::string o;
-			o.reserve(256);
-			o.push_back('{');
-			for (const auto& [key, val] : v) {
-				if (o.size() > 1)
-					o.push_back(',');
-				o.append(string_of_string(key))
-				.append(":"sv)
-				.append(val.to_string(pass_thru));
-			}
-			o.push_back('}');
-			return o;
-		};
-		// return external form of JSON "array"
-		auto string_of_arr = [&](const auto& v) {
-			std::string o;
-			o.reserve(256);
-			o.push_back('[');
-			for (const auto& e : v) {
-				if (o.size() > 1)
-					o.push_back(',');
-				o.append(e.to_string(pass_thru));
-			}
-			o.push_back(']');
-			return o;
-		};
-		// return external form of JSON "value"
-		return std::visit(overload{
-			[&](nullptr_t) { return "null"s; },
-			[&](bool) { return as_bool() ? "true"s : "false"s; },
-			[&](double) {
-				char b[32];
-				const auto [p, e] = std::to_chars(b, b + std::size(b), as_num());
-				return std::string{ b, p };
-			},
-			[&](const std::string&) { return string_of_string(as_string()); },
-			[&](const js_obj&) { return string_of_obj(as_obj()); },
-			[&](const js_arr&) { return string_of_arr(as_arr()); }
-		}, get_base());
-	}
-
-	/*
-		Fully parse the supplied source string_view into an in-memory rmj::js_val,
-		as specified in RFC 8259 (which obsoletes 4627, 7158, and 7159)... it should
-		be noted that rmj::parse accepts "bare" values, not only objects or arrays.
-
-		We expect the input to be encoded as utf-8 (which, of course, means ASCII is
-		accepted).  But do note the comment on rmj::to_string above relating to, for
-		instance, "round trips".
-
-		Attempt to detect badly-formed JSON, and throw std::runtime_error exceptions
-		that include explanatory ".what()" text that includes the BYTE offset in the
-		incoming source string_view where the parser detected the offending sequence.
-	*/
-	static js_val parse(std::string_view src) {
-		using namespace detail;
-		size_t co{}; // ("current offset")
 		// classifier: JSON "whitespace"
-		constexpr auto is_ws = [](auto c) noexcept { return c == ' ' || c == '\n' || c == '\r' || c == '\t'; };
+		static constexpr auto is_ws(char c) noexcept { return c == ' ' || c == '\n' || c == '\r' || c == '\t'; }
 		// skip over POSSIBLE "whitespace", co -> 1st NON-whitespace
-		auto ws = [&]() noexcept {
+		void ws() noexcept {
 			while (co < src.size() && is_ws(src[co]))
 				++co;
-		};
+		}
 		// skip over "digits", co -> 1st NON-digit
-		auto digits = [&]() noexcept {
-			while (++co < src.size() && isdigit(src[co])) ;
-		};
+		void digits() noexcept {
+			while (++co < src.size() && detail::isdigit(src[co])) ;
+		}
 		// skip over JSON "keyword" chars, co -> 1st NON-alpha
-		auto alphas = [&]() noexcept {
-			while (++co < src.size() && isalpha(src[co])) ;
-		};
-		// parse JSON "number", converting to IEEE 64-bit float (aka "double")
-		auto number = [&]() {
+		void alphas() noexcept {
+			while (++co < src.size() && detail::isalpha(src[co])) ;
+		}
+
+		// classify [next] JSON token, WITHOUT consuming it... "value" tokens are
+		// in_string, in_number, or in_keyword (then read using the methods below)
+		parse_state next() noexcept {
+			using enum parse_state;
+			if (ws(); co >= src.size())
+				return eod;
+			switch (src[co]) {
+			case '"':
+				return in_string;
+			case ',':
+				return more_items;
+			case '-':
+			case '0': case '1': case '2': case '3': case '4':
+			case '5': case '6': case '7': case '8': case '9':
+				return in_number;
+			case ':':
+				return obj_colon;
+			case '[':
+				return in_array;
+			case ']':
+				return end_array;
+			case 'f': case 'n': case 't':
+				return in_keyword;
+			case '{':
+				return in_object;
+			case '}':
+				return end_object;
+			default:
+				return illegal;
+			}
+		}
+
+		// skip over [and check] JSON "number", returning its starting offset (and
+		// noting if it's integral, i.e., has NEITHER fraction NOR exponent)
+		bool integral{};
+		size_t skip_number() {
 			// classifier: [tokens ending] JSON "number"
-			constexpr auto is_eon = [](auto c) noexcept { return c == ',' || c == '}' || c == ']'; };
+			constexpr auto is_eon = [](char c) noexcept { return c == ',' || c == '}' || c == ']'; };
 			const auto start{ co };
-			double d{};
+			// (a '-' MUST be followed by a digit... and a leading '0' by NO digit)
+			const auto first{ src[start] == '-' ? start + 1 : start };
+			if (first >= src.size() || !detail::isdigit(src[first]))
+				throw std::runtime_error("Bad parse (NUMBER) @ "s + std::to_string(base + first));
 			digits();
+			if (src[first] == '0' && co - first > 1)
+				throw std::runtime_error("Bad parse (NUMBER) @ "s + std::to_string(base + start));
 			if (co >= src.size() || is_ws(src[co]) || is_eon(src[co])) {
-				// legal number, i.e., NO leading zero [on MULTI-digit token]?
-				if (src[start] == '0' && (co - start) > 1)
-					throw std::runtime_error("Bad parse (NUMBER) @ "s + std::to_string(start));
 				// have integral value
-				ignore(std::from_chars(src.data() + start, src.data() + co, d));
-				return d;
+				integral = true;
+				return start;
 			}
+			integral = false;
 			if (src[co] == '.') {
-				if (++co >= src.size() || !isdigit(src[co]))
-					throw std::runtime_error("Bad parse (NUMBER) @ "s + std::to_string(co));
+				if (++co >= src.size() || !detail::isdigit(src[co]))
+					throw std::runtime_error("Bad parse (NUMBER) @ "s + std::to_string(base + co));
 				digits();
 			}
-			if (co >= src.size() || is_ws(src[co]) || is_eon(src[co])) {
+			if (co >= src.size() || is_ws(src[co]) || is_eon(src[co]))
 				// have fixed-point value
-				ignore(std::from_chars(src.data() + start, src.data() + co, d));
-				return d;
-			}
+				return start;
 			if (auto c = src[co]; c == 'e' || c == 'E') {
 				if (++co >= src.size())
-					throw std::runtime_error("Bad parse (NUMBER) @ "s + std::to_string(co));
+					throw std::runtime_error("Bad parse (NUMBER) @ "s + std::to_string(base + co));
 				if (c = src[co]; c == '+' || c == '-')
 					++co;
-				if (co >= src.size() || !isdigit(src[co]))
-					throw std::runtime_error("Bad parse (NUMBER) @ "s + std::to_string(co));
+				if (co >= src.size() || !detail::isdigit(src[co]))
+					throw std::runtime_error("Bad parse (NUMBER) @ "s + std::to_string(base + co));
 				digits();
 				// have fixed-point value WITH exponent
-				ignore(std::from_chars(src.data() + start, src.data() + co, d));
-				return d;
+				return start;
 			}
-			throw std::runtime_error("Bad parse (NUMBER) @ "s + std::to_string(co));
-		};
-		// parse JSON "keyword"
-		auto keyword = [&]() {
+			throw std::runtime_error("Bad parse (NUMBER) @ "s + std::to_string(base + co));
+		}
+		// read JSON "number", passing it to f as an exact integer if it IS one (and
+		// fits), accumulating its digits directly... else converting it to IEEE
+		// 64-bit float (aka "double")
+		// N.B. - "-0" is NOT an integer, as only a double can keep its sign
+		template<class F>
+		decltype(auto) number(F&& f) {
+			const auto start{ skip_number() };
+			if (integral) {
+				const bool neg{ src[start] == '-' };
+				if (const auto n{ co - start - neg }; n < 20) {
+					uint64_t u{};
+					for (auto p{ start + neg }; p < co; ++p)
+						u = u * 10 + uint64_t(src[p] - '0');
+					if (u <= uint64_t(INT64_MAX) + neg && (u || !neg))
+						return f(neg ? js_int(0 - u) : js_int(u));
+				}
+			}
+			double d{};
+			detail::ignore(std::from_chars(src.data() + start, src.data() + co, d));
+			return f(d);
+		}
+		// read JSON "keyword"
+		js_val keyword() {
 			const auto start{ co };
 			alphas();
 			if (const auto t{ src.substr(start, co - start) }; t == "null"sv)
@@ -594,34 +1670,47 @@ public:
 				return js_val{ true };
 			else if (t == "false"sv)
 				return js_val{ false };
-			throw std::runtime_error("Bad parse ([unexpected] KEYWORD) @ "s + std::to_string(start));
-		};
-		// parse JSON "string", converting to internal utf-8 "-friendly" form
-		auto string = [&]() {
+			throw std::runtime_error("Bad parse ([unexpected] KEYWORD) @ "s + std::to_string(base + start));
+		}
+		// read JSON "string" (into ANY char_sink), converting to internal utf-8 "-friendly" form
+		template<detail::char_sink Sink>
+		void string(Sink& o) {
+			using namespace detail;
 			// (handle utf-16 Basic Multilingual Plane as well as surrogate pairs)
 			// N.B. - std::from_chars doesn't [yet] support char16_t as a "target"
 			auto utf16 = [&]() {
 				if (co + 5 >= src.size())
-					throw std::runtime_error("Bad parse (STRING: invalid utf-16 sequence) @ "s + std::to_string(co - 1));
+					throw std::runtime_error("Bad parse (STRING: invalid utf-16 sequence) @ "s + std::to_string(base + co - 1));
+				// (N.B. - ALL 4 chars MUST be hex digits, or we could "lose" a '"')
+				auto hex4 = [&](char16_t& u) {
+					if (std::from_chars(src.data() + co, src.data() + co + 4, (uint16_t&)u, 16).ptr != src.data() + co + 4)
+						throw std::runtime_error("Bad parse (STRING: invalid utf-16 sequence) @ "s + std::to_string(base + co));
+					co += 4;
+				};
 				char16_t u[2]{};
 				++co;
-				ignore(std::from_chars(src.data() + co, src.data() + co + 4, (uint16_t&)u[0], 16));
-				co += 4;
+				hex4(u[0]);
 				if (sizeOfUTF16CodeUnits(u[0]) > 1)
 					if (co + 6 >= src.size() || src[co] != '\\' || src[co + 1] != 'u')
-						throw std::runtime_error("Bad parse (STRING: invalid utf-16 surrogate pair) @ "s + std::to_string(co));
+						throw std::runtime_error("Bad parse (STRING: invalid utf-16 surrogate pair) @ "s + std::to_string(base + co));
 					else {
 						co += 2;
-						ignore(std::from_chars(src.data() + co, src.data() + co + 4, (uint16_t&)u[1], 16));
-						co += 4;
+						hex4(u[1]);
 					}
 				return codePointFromUTF16(u);
 			};
-			std::string o;
-			o.reserve(256);
 			++co;
-			while (co < src.size() && src[co] != '"')
+			while (co < src.size()) {
+				// (bulk-append any run of "clean" chars NOT needing special handling)
+				// N.B. - "control" chars are [still] accepted as-is in JSON strings
+				const auto p{ find_string_special<false>(src.data() + co, src.data() + src.size()) };
+				if (const auto n{ size_t(p - src.data()) - co }; n)
+					o.append(src.data() + co, n), co += n;
+				if (co >= src.size() || src[co] == '"')
+					break;
 				if (src[co] == '\\') {
+					if (co + 1 >= src.size())
+						break; // (let the termination check below complain)
 					switch (src[++co]) {
 					case '"': o.push_back('"'); break;
 					case '\\': o.push_back('\\'); break;
@@ -636,123 +1725,2618 @@ public:
 						--co; // (pre-compensate for below "++co")
 						break;
 					default:
-						throw std::runtime_error("Bad parse (STRING: invalid escaped char) @ "s + std::to_string(co));
+						throw std::runtime_error("Bad parse (STRING: invalid escaped char) @ "s + std::to_string(base + co));
 					}
 					++co;
 				} else {
-					auto n = sizeOfUTF8CodeUnits((char8_t)src[co]);
-					if (!n || co + n > src.size())
-						throw std::runtime_error("Bad parse (STRING: invalid utf-8 sequence) @ "s + std::to_string(co));
-					while (n--)
-						o.push_back(src[co++]);
+					// (validate an entire run of utf-8 multi-byte sequences, THEN append)
+					const auto start{ co };
+					// N.B. - continuation bytes are checked too, so that NO '"' or '\\' can
+					// ever be "swallowed" by a malformed multi-byte sequence
+					do {
+						const auto n = sizeOfUTF8CodeUnits((char8_t)src[co]);
+						if (!n || co + n > src.size())
+							throw std::runtime_error("Bad parse (STRING: invalid utf-8 sequence) @ "s + std::to_string(base + co));
+						for (size_t i = 1; i < n; ++i)
+							if (((char8_t)src[co + i] & 0b11000000) != 0b10000000)
+								throw std::runtime_error("Bad parse (STRING: invalid utf-8 sequence) @ "s + std::to_string(base + co));
+						co += n;
+					} while (co < src.size() && (char8_t)src[co] >= 0x80);
+					o.append(src.data() + start, co - start);
 				}
+			}
 			if (co >= src.size() || src[co++] != '"')
-				throw std::runtime_error("Bad parse (STRING: invalid termination) @ "s + std::to_string(co));
-			return o;
+				throw std::runtime_error("Bad parse (STRING: invalid termination) @ "s + std::to_string(base + co));
+		}
+	};
+
+	// read a js_raw_num [again], EXACTLY as parse would have without lazy_numbers
+	// N.B. - this can NOT throw, as a js_raw_num's text is ALWAYS a valid number
+	js_val raw_number() const noexcept {
+		lexer lx{ std::get<js_raw_num>(get_base()).text(), 0 };
+		return lx.number([](auto n) { return js_val{ n }; });
+	}
+
+public:
+	/*
+		Create an external string representation that is presumably valid RFC 8259
+		JSON text... the chances of this being the case are MUCH higher if the parsed
+		[internal] representation was itself created by parsing a valid RFC 8259 doc.
+
+		A special note on anyone doing "round trip" testing: while parsing the UTF-8
+		input, if any UTF-16 "escaped" characters are seen, they will be converted to
+		their utf-8 encoding forms... this applies to both Basic Multilingual Plane
+		characters as well as any utf-16 "surrogate pairs".  This means that utf-16
+		"escaped" characters that were present prior to parsing will, on output by
+		rmj::to_string, appear as their EXACTLY EQUIVALENT utf-8 forms... which MAY
+		include some "control characters" (U+0000 - U+001F) represented as "\u00nn".
+
+		For the "official" v1 release, the above is still true - but NOT as default
+		behavior.  The default is to output any non-ASCII and "control" characters
+		using JSON "escape" sequences... these are fully compatible and equivalent,
+		and defined in the JSON standard referenced above - but always printable.
+		To get the full "UNICODE-encoded-as-UTF-8" behavior for string output, just
+		call the public to_string fn with a bool 'true' parameter.
+
+		An important note on both to_string and parse (below) is that they are based
+		on the C++ library functions std::to_chars and std::from_chars... while this
+		is a Good Thing(tm) - in that "round trips" of JSON numbers (recall these are
+		represented by IEEE 754 64-bit floating point numbers, aka "doubles") will be
+		GUARANTEED to be symmetric - in that numeric values output by RMj will always
+		be a) readable by RMj, and b) they will result in the SAME internal numeric
+		value.  However, what may not match is attempting to compare these displayed
+		values with those output by other methods, such as the conversions performed
+		when outputting (and then inputting) doubles when using the C++ library "std"
+		stream input and output operations.
+
+		As an additional note on "round trips", any JSON text that included a BOM at
+		the beginning was politely accepted, after IGNORING said BOM... and under no
+		circumstances is any attempt made to remember this and include it in the new
+		version of the JSON text produced by to_string, as this would be in violation
+		of RFC 8259 - and a Bad Idea(tm) in general.
+	*/
+	constexpr std::string to_string(bool pass_thru = false) const {
+		std::string o;
+		stringify(o, pass_thru);
+		return o;
+	}
+
+	/*
+		The actual serialization "engine" behind to_string (as well as operator<<
+		and the std::format formatter)... the ENTIRE js_val tree is written in one
+		pass to the supplied output "sink" (see detail::char_sink), with NO interim
+		strings being created for nested objects, arrays, or [string] values.
+
+		This means that a caller-supplied std::string may be re-used across calls
+		(just clear() it first), so that after "warming up", NO allocations at all
+		should be taking place during serialization.
+	*/
+	template<detail::char_sink Sink>
+	constexpr void stringify(Sink& o, bool pass_thru = false) const {
+		using namespace detail;
+		std::visit(overload{
+			[&](nullptr_t) { o.append("null", 4); },
+			[&](bool v) { v ? o.append("true", 4) : o.append("false", 5); },
+			[&](double v) { stringify_num(o, v); },
+			[&](js_int v) { stringify_num(o, v); },
+			[&](const js_raw_num& v) { o.append(v.text().data(), v.text().size()); },
+			[&](const js_str& v) { stringify_string(o, v, pass_thru); },
+			[&](const js_obj&) {
+				// output external form of JSON "object"
+				o.push_back('{');
+				bool first{ true };
+				for (const auto& [key, val] : as_obj()) {
+					if (!first)
+						o.push_back(',');
+					first = false;
+					stringify_string(o, key, pass_thru);
+					o.push_back(':');
+					val.stringify(o, pass_thru);
+				}
+				o.push_back('}');
+			},
+			[&](const js_arr&) {
+				// output external form of JSON "array"
+				o.push_back('[');
+				bool first{ true };
+				for (const auto& e : as_arr()) {
+					if (!first)
+						o.push_back(',');
+					first = false;
+					e.stringify(o, pass_thru);
+				}
+				o.push_back(']');
+			}
+		}, get_base());
+	}
+
+	/*
+		Encode as binary CBOR (RFC 8949) or MessagePack, rather than as JSON text...
+		to_binary returns the bytes, while encode writes them to ANY output "sink",
+		just as stringify does.  Objects become maps (with string keys), js_ints
+		become integers, and doubles become floats (when that is exact) or doubles,
+		so NO escaping of strings or formatting of numbers is needed at either end.
+
+		N.B. - a js_raw_num is encoded as the value it stands for (see raw_number)
+	*/
+	std::string to_binary(binary_format f) const {
+		std::string o;
+		encode(o, f);
+		return o;
+	}
+	template<detail::char_sink Sink>
+	void encode(Sink& o, binary_format f) const {
+		using namespace detail;
+		const auto cbor{ f == binary_format::cbor };
+		// (lead byte b, then the n-byte big-endian value v)
+		auto put = [&](uint8_t b, uint64_t v, size_t n) {
+			char t[9]{ char(b) };
+			for (size_t i{}; i < n; ++i)
+				t[n - i] = char(v >> 8 * i);
+			o.append(t, n + 1);
+		};
+		// (CBOR "head" of major type m, and v - i.e., a count, or an integer)
+		auto head = [&](uint8_t m, uint64_t v) {
+			if (m <<= 5; v < 24)
+				o.push_back(char(m | v));
+			else
+				v <= UINT8_MAX ? put(m | 24, v, 1) : v <= UINT16_MAX ? put(m | 25, v, 2)
+					: v <= UINT32_MAX ? put(m | 26, v, 4) : put(m | 27, v, 8);
+		};
+		// (... or [in MessagePack] the "fix" form's lead byte fix, if n <= most,
+		// else the lead byte for 8 (if any), 16 or [b16 + 1] 32-bit n)
+		auto count = [&](uint8_t m, size_t n, size_t most, uint8_t fix, uint8_t b8, uint8_t b16) {
+			if (cbor)
+				head(m, n);
+			else if (n <= most)
+				o.push_back(char(fix | n));
+			else if (b8 && n <= UINT8_MAX)
+				put(b8, n, 1);
+			else if (n <= UINT32_MAX)
+				n <= UINT16_MAX ? put(b16, n, 2) : put(b16 + 1, n, 4);
+			else
+				throw std::length_error("Bad encode (MessagePack: string, object or array too large)");
 		};
+		auto string = [&](std::string_view v) {
+			count(3, v.size(), 31, 0xa0, 0xd9, 0xda);
+			o.append(v.data(), v.size());
+		};
+		std::visit(overload{
+			[&](nullptr_t) { o.push_back(cbor ? '\xf6' : '\xc0'); },
+			[&](bool v) { o.push_back(cbor ? v ? '\xf5' : '\xf4' : v ? '\xc3' : '\xc2'); },
+			[&](double v) {
+				// (N.B. - float(v) is ONLY safe for a v in its range... and NOT a NaN)
+				if (constexpr auto m{ std::numeric_limits<float>::max() }; v >= -m && v <= m && double(float(v)) == v)
+					put(cbor ? 0xfa : 0xca, std::bit_cast<uint32_t>(float(v)), 4);
+				else
+					put(cbor ? 0xfb : 0xcb, std::bit_cast<uint64_t>(v), 8);
+			},
+			[&](js_int v) {
+				if (cbor)
+					v < 0 ? head(1, uint64_t(-1 - v)) : head(0, uint64_t(v));
+				else if (v >= -32 && v <= 127)
+					o.push_back(char(v));
+				else if (v >= 0)
+					v <= UINT8_MAX ? put(0xcc, v, 1) : v <= UINT16_MAX ? put(0xcd, v, 2)
+						: v <= UINT32_MAX ? put(0xce, v, 4) : put(0xcf, v, 8);
+				else
+					v >= INT8_MIN ? put(0xd0, v, 1) : v >= INT16_MIN ? put(0xd1, v, 2)
+						: v >= INT32_MIN ? put(0xd2, v, 4) : put(0xd3, v, 8);
+			},
+			[&](const js_raw_num&) { raw_number().encode(o, f); },
+			[&](const js_str& v) { string(v); },
+			[&](const js_obj& m) {
+				count(5, m.size(), 15, 0x80, 0, 0xde);
+				for (const auto& [key, val] : as_obj()) {
+					string(key);
+					val.encode(o, f);
+				}
+			},
+			[&](const js_arr& a) {
+				count(4, a.size(), 15, 0x90, 0, 0xdc);
+				for (const auto& e : as_arr())
+					e.encode(o, f);
+			}
+		}, get_base());
+	}
+
+	/*
+		Fully parse the supplied source string_view into an in-memory rmj::js_val,
+		as specified in RFC 8259 (which obsoletes 4627, 7158, and 7159)... it should
+		be noted that rmj::parse accepts "bare" values, not only objects or arrays.
+
+		We expect the input to be encoded as utf-8 (which, of course, means ASCII is
+		accepted).  But do note the comment on rmj::to_string above relating to, for
+		instance, "round trips".
+
+		Attempt to detect badly-formed JSON, and throw std::runtime_error exceptions
+		that include explanatory ".what()" text that includes the BYTE offset in the
+		incoming source string_view where the parser detected the offending sequence.
+
+		See rmj::parse_opts for the available [optional] variations in behavior.
+	*/
+	static js_val parse(std::string_view src, const parse_opts& opts = {}) {
+		using namespace detail;
+		lexer lx{ src, opts };
+		auto& co{ lx.co };
+		// (ALL strings and containers created below get their storage from here)
+#ifdef USE_PMR
+		const js_alloc<char> alloc{ opts.mr ? opts.mr : std::pmr::get_default_resource() };
+#else
+		const js_alloc<char> alloc{};
+#endif
 		// parse [next] JSON token, returning EITHER "value" OR "parse state"
 		auto next_token = [&]() -> val_or_state {
+			switch (const auto s{ lx.next() }) {
 			using enum parse_state;
-			if (ws(); co >= src.size())
-				return eod;
-			switch (src[co]) {
-			case '"':
-				return string();
-			case ',':
-				return more_items;
-			case '-':
-			case '0': case '1': case '2': case '3': case '4':
-			case '5': case '6': case '7': case '8': case '9':
-				return number();
-			case ':':
-				return obj_colon;
-			case '[':
-				return in_array;
-			case ']':
-				return end_array;
-			case 'f': case 'n': case 't':
-				return keyword();
-			case '{':
-				return in_object;
-			case '}':
-				return end_object;
+			case in_string: {
+				// N.B. - NO reserve() here, as short strings (think, most object keys!)
+				// should NOT need any heap allocation at all
+				js_str o(alloc);
+				lx.string(o);
+				return js_val{ std::move(o) };
+			}
+			case in_number:
+				if (opts.lazy_numbers) {
+					const auto start{ lx.skip_number() };
+					return js_val{ js_raw_num{ src.substr(start, co - start) } };
+				}
+				return lx.number([](auto n) -> val_or_state { return js_val{ n }; });
+			case in_keyword:
+				return lx.keyword();
 			default:
-				return illegal;
+				return s;
 			}
 		};
-		// primary [recursive] parser, returning JSON "value"
-		auto parse_impl = [&](auto&& parse_impl) -> js_val {
-			js_val value{};
-			if (auto t = next_token(); has_val(t))
-				value = val(t);
+		// primary [iterative] parser, returning JSON "value"... each open object
+		// or array is a "frame" on an explicit stack (NOT the C++ call stack), so
+		// that ONLY max_depth - and NOT the size of the thread's stack - limits the
+		// nesting allowed (which also avoids any per-level function call overhead)
+		struct frame {
+			js_val v; // (the open object or array)
+			js_str key; // (... and ITS key, if it's a member of an object)
+		};
+		// (the stack is re-used by EVERY parse on this thread, so needs NO allocations
+		// once "warmed up"... but it MUST be left empty, even if we throw)
+		thread_local std::vector<frame> frames;
+		auto& stack{ frames };
+		struct release {
+			std::vector<frame>& s;
+			~release() { s.clear(); }
+		} guard{ stack };
+		if (!stack.capacity())
+			stack.reserve(32);
+		js_val root{};
+		js_str key(alloc); // (key of the NEXT member of the innermost object)
+		// add a COMPLETE value to the innermost open object or array (or, if none
+		// is open, it's the root value we're done with)
+		auto add = [&](js_val&& v) {
+			if (stack.empty())
+				root = std::move(v);
+			else if (auto& f{ stack.back().v }; f.is_obj())
+				add_member(f.as_obj(), std::move(key), std::move(v));
+			else
+				f.as_arr().push_back(std::move(v));
+		};
+		// read [next] "key" and ':' of an object, then the token following them
+		auto member = [&](val_or_state& t) {
+			if (!has_val(t) || !val(t).is_string())
+				throw std::runtime_error("Bad parse (OBJECT: expected STRING) @ "s + std::to_string(co));
+			else if (const auto u = next_token(); !has_state(u) || state(u) != parse_state::obj_colon)
+				throw std::runtime_error("Bad parse (OBJECT: expected ':') @ "s + std::to_string(co));
+			key = std::move(take(t).as_string());
+			++co, t = next_token();
+		};
+		auto t{ next_token() };
+		for (;;) {
+			// t MUST begin a value, either "simple", or an object or array
+			if (has_val(t))
+				add(take(t));
 			else
-				switch (state(t)) {
+				switch (const auto s{ state(t) }) {
 				using enum parse_state;
-				case in_object: {
-					// (store JSON "object" as C++ std::map of JSON "values")
-					value = js_obj();
-					auto& mr = value.as_obj();
-					do {
-						++co, t = next_token();
+				case in_object:
+				case in_array:
+					if (opts.max_depth && stack.size() >= opts.max_depth)
+						throw std::runtime_error("Bad parse (maximum depth exceeded) @ "s + std::to_string(co));
+					// (store JSON "object" as C++ std::map, "array" as std::vector)
+					stack.push_back({ s == in_object ? js_val{ js_obj(alloc) } : js_val{ js_arr(alloc) }, std::move(key) });
+					if (++co, t = next_token(); s == in_object) {
 						// check for [and ALLOW] "empty" object
-						if (has_state(t) && state(t) == end_object && mr.empty())
+						if (has_state(t) && state(t) == end_object)
 							break;
-						else if (!has_val(t) || !val(t).is_string())
+						member(t);
+					} else if (has_state(t) && state(t) == end_array)
+						// (... and ALLOW "empty" array)
+						break;
+					else if (has_state(t) && (state(t) != in_object && state(t) != in_array))
+						throw std::runtime_error("Bad parse (expected VALUE) @ "s + std::to_string(co));
+					// (go parse the FIRST member / element)
+					continue;
+				default:
+					// we MUST see a VALUE!
+					throw std::runtime_error("Bad parse (expected VALUE) @ "s + std::to_string(co));
+				}
+			// a value is complete... see what follows it in the innermost object or
+			// array, which may then ITSELF be complete (and so on)
+			for (;;) {
+				using enum parse_state;
+				if (has_state(t) && (state(t) == end_object || state(t) == end_array)) {
+					++co; // (consume '}' or ']')
+					auto& f{ stack.back() };
+					if (f.v.is_obj())
+						end_members(f.v.as_obj());
+					js_val v{ std::move(f.v) };
+					key = std::move(f.key);
+					stack.pop_back();
+					add(std::move(v));
+				}
+				if (stack.empty())
+					return root;
+				const auto obj{ stack.back().v.is_obj() };
+				if (t = next_token(); has_state(t) && state(t) == more_items) {
+					if (++co, t = next_token(); obj)
+						member(t);
+					else if (has_state(t) && (state(t) != in_object && state(t) != in_array))
+						throw std::runtime_error("Bad parse (expected VALUE) @ "s + std::to_string(co));
+					break;
+				}
+				if (obj && (!has_state(t) || state(t) != end_object))
+					throw std::runtime_error("Bad parse (OBJECT: expected ',' or '}') @ "s + std::to_string(co));
+				if (!obj && (!has_state(t) || state(t) != end_array))
+					throw std::runtime_error("Bad parse (ARRAY: expected ',' or ']') @ "s + std::to_string(co));
+			}
+		}
+	}
+
+	/*
+		"Streaming" (aka SAX-style) parse of the supplied source string_view, which
+		performs exactly the same checking as the "tree-building" parse above, but
+		instead of creating ANY js_vals, calls the "event" methods of the supplied
+		handler (see rmj::sax_handler) as each part of the JSON text is recognized.
+
+		Strings (both keys and values) are passed to the handler as string_views,
+		which are usually views of the source text itself... but any string having
+		escapes is "unescaped" into a [re-used] scratch buffer, so do NOT hold on to
+		any of these views past the return of the event method they were passed to.
+
+		This is the way to go when counting, filtering, or forwarding the contents
+		of JSON text, as NO allocations at all are made for the values themselves.
+	*/
+	template<detail::sax_events Handler>
+	static void parse(std::string_view src, Handler&& h, const parse_opts& opts = {}) {
+		using namespace detail;
+		lexer lx{ src, opts };
+		auto& co{ lx.co };
+		std::string scratch;
+		auto string = [&]() {
+			view_sink o{ scratch };
+			lx.string(o);
+			return o.view();
+		};
+		// primary [iterative] parser, with NO values returned... the open objects
+		// and arrays ('{' or '[') are kept on an explicit stack, as in parse above
+		std::string stack;
+		auto t{ lx.next() };
+		for (;;) {
+			// t MUST begin a value, either "simple", or an object or array
+			switch (t) {
+			using enum parse_state;
+			case in_string:
+				h.value(string());
+				break;
+			case in_number:
+				lx.number([&](auto n) { number_event(h, n); });
+				break;
+			case in_keyword:
+				if (const auto k{ lx.keyword() }; k.is_null())
+					h.value(nullptr);
+				else
+					h.value(k.as_bool());
+				break;
+			case in_object:
+			case in_array:
+				if (opts.max_depth && stack.size() >= opts.max_depth)
+					throw std::runtime_error("Bad parse (maximum depth exceeded) @ "s + std::to_string(co));
+				if (t == in_object) {
+					stack.push_back('{');
+					h.start_object();
+					// check for [and ALLOW] "empty" object
+					if (++co, t = lx.next(); t != end_object) {
+						if (t != in_string)
 							throw std::runtime_error("Bad parse (OBJECT: expected STRING) @ "s + std::to_string(co));
-						else if (const auto u = next_token(); !has_state(u) || state(u) != obj_colon)
+						h.key(string());
+						if (lx.next() != obj_colon)
 							throw std::runtime_error("Bad parse (OBJECT: expected ':') @ "s + std::to_string(co));
-						auto v = (++co, parse_impl(parse_impl));
-						mr.try_emplace(val(t).as_string(), std::move(v));
-						if (t = next_token(); has_state(t) && state(t) == end_object)
-							break;
-					} while (has_state(t) && state(t) == more_items);
-					if (!has_state(t) || state(t) != end_object)
-						throw std::runtime_error("Bad parse (OBJECT: expected ',' or '}') @ "s + std::to_string(co));
-					++co; // (consume '}')
-					break;
+						++co, t = lx.next();
+						continue;
+					}
+				} else {
+					stack.push_back('[');
+					h.start_array();
+					// check for [and ALLOW] "empty" array
+					if (++co, t = lx.next(); t != end_array)
+						continue;
 				}
-				case in_array: {
-					// (store JSON "array" as C++ std::vector of JSON "values")
-					value = js_arr();
-					auto& ar = value.as_arr();
-					do {
-						++co, t = next_token();
-						// check for [and ALLOW] "empty" array
-						if (has_state(t) && state(t) == end_array && ar.empty())
-							break;
-						else if (has_state(t) && (state(t) != in_object && state(t) != in_array))
-							throw std::runtime_error("Bad parse (expected VALUE) @ "s + std::to_string(co));
-						auto v = has_val(t) ? val(t) : parse_impl(parse_impl);
-						ar.push_back(std::move(v));
-						if (t = next_token(); has_state(t) && state(t) == end_array)
-							break;
-					} while (has_state(t) && state(t) == more_items);
-					if (!has_state(t) || state(t) != end_array)
-						throw std::runtime_error("Bad parse (ARRAY: expected ',' or ']') @ "s + std::to_string(co));
-					++co; // (consume ']')
-					break;
+				break;
+			default:
+				// we MUST see a VALUE!
+				throw std::runtime_error("Bad parse (expected VALUE) @ "s + std::to_string(co));
+			}
+			// a value is complete... see what follows it in the innermost object or
+			// array, which may then ITSELF be complete (and so on)
+			for (;;) {
+				using enum parse_state;
+				if (t == end_object || t == end_array) {
+					++co; // (consume '}' or ']')
+					stack.back() == '{' ? h.end_object() : h.end_array();
+					stack.pop_back();
 				}
-				default:
-					// we MUST return a VALUE!
-					throw std::runtime_error("Bad parse (expected VALUE) @ "s + std::to_string(co));
+				if (stack.empty())
+					return;
+				if (t = lx.next(); t == more_items) {
+					if (++co, t = lx.next(); stack.back() == '{') {
+						if (t != in_string)
+							throw std::runtime_error("Bad parse (OBJECT: expected STRING) @ "s + std::to_string(co));
+						h.key(string());
+						if (lx.next() != obj_colon)
+							throw std::runtime_error("Bad parse (OBJECT: expected ':') @ "s + std::to_string(co));
+						++co, t = lx.next();
+					}
+					break;
 				}
-			return value;
-		};
-		// Detect and IGNORE utf-8 BOM at beginning of JSON text... (not reversible)
-		if (src.size() >= 3 &&
-			(char8_t)src[0] == 0xEF &&
-			(char8_t)src[1] == 0xBB &&
-			(char8_t)src[2] == 0xBF)
-			co += 3;
-		return parse_impl(parse_impl);
+				if (stack.back() == '{' && t != end_object)
+					throw std::runtime_error("Bad parse (OBJECT: expected ',' or '}') @ "s + std::to_string(co));
+				if (stack.back() == '[' && t != end_array)
+					throw std::runtime_error("Bad parse (ARRAY: expected ',' or ']') @ "s + std::to_string(co));
+			}
+		}
 	}
-};
 
-// "user-defined suffix" HELPFUL when using "bare" INTEGERS in js_val exprs...
-// the alternative is using casts - think, (js_num)0, (js_num)1, (js_num)2 vs:
-// e.g., js_arr a{0, 1, 2} => js_arr a{0_js, 1_js, 2_js}, whereas
-// e.g., js_arr a{0.0, 1.0, 2.0} is correctly defined/legal as is
-constexpr auto operator""_js(unsigned long long v) noexcept { return (js_num)v; }
+	/*
+		Parse the JSON text in the file at path... exactly as parse() above, but
+		parsing directly from the file's memory-mapped contents (see mapped_file),
+		so no copy of [what may be a very large] file is ever made.
+
+		In addition to the exceptions thrown by parse(), a std::system_error is
+		thrown if the file can't be opened or mapped.
+	*/
+	static js_val parse_file(const std::filesystem::path& path, const parse_opts& opts = {}) {
+		const mapped_file f{ path };
+		// (js_raw_nums would outlive the mapping of the text they're views of)
+		auto o{ opts };
+		o.lazy_numbers = false;
+		return parse(f.view(), o);
+	}
+
+	/*
+		Decode ONE value encoded as CBOR (RFC 8949) or MessagePack (see encode), read
+		from ANY input "source" (see detail::byte_source)... reading ONLY as many
+		bytes as that value needs, so a stream of values may be decoded one by one.
+		parse_binary instead decodes ALL of src, which must hold exactly one value.
+
+		Text strings (which MUST be valid UTF-8) become js_strs, integers too large
+		for a js_int become doubles, and CBOR "tags" are simply skipped... while
+		anything else without a JSON equivalent (e.g., byte strings, non-string
+		keys, NaNs and infinities, or MessagePack "ext" types) throws a
+		std::runtime_error giving its byte offset, just as parse() does.  Nesting is
+		limited by the parse_opts max_depth (and under USE_PMR, mr is used) as well.
+	*/
+	template<detail::byte_source Source>
+	static js_val decode(Source& src, binary_format f, const parse_opts& opts = {}) {
+		using namespace detail;
+		const auto cbor{ f == binary_format::cbor };
+#ifdef USE_PMR
+		const js_alloc<char> alloc{ opts.mr ? opts.mr : std::pmr::get_default_resource() };
+#else
+		const js_alloc<char> alloc{};
+#endif
+		size_t at{}; // (offset of the NEXT byte)
+		auto fail = [&](const char* what) {
+			throw std::runtime_error("Bad "s + (cbor ? "CBOR" : "MessagePack") + " (" + what + ") @ " + std::to_string(at));
+		};
+		auto read = [&](char* p, size_t n) {
+			if (!src.read(p, n))
+				fail("unexpected end");
+			at += n;
+		};
+		auto byte = [&]() {
+			char c;
+			read(&c, 1);
+			return uint8_t(c);
+		};
+		// (n-byte big-endian unsigned integer)
+		auto uint = [&](size_t n) {
+			char t[8];
+			read(t, n);
+			uint64_t v{};
+			for (size_t i{}; i < n; ++i)
+				v = v << 8 | uint8_t(t[i]);
+			return v;
+		};
+		// (append n bytes to t... in "chunks", so a bogus n can't allocate too much)
+		auto bytes = [&](js_str& t, uint64_t n) {
+			while (n) {
+				const auto k{ size_t(std::min<uint64_t>(n, 65536)) }, z{ t.size() };
+				t.resize(z + k);
+				read(t.data() + z, k);
+				n -= k;
+			}
+		};
+		auto text = [&](js_str&& t) {
+			if (!is_utf8(t))
+				fail("invalid utf-8 sequence");
+			return js_val{ std::move(t) };
+		};
+		auto string = [&](uint64_t n) {
+			js_str t(alloc);
+			bytes(t, n);
+			return text(std::move(t));
+		};
+		// (JSON has NO NaNs or infinities)
+		auto real = [&](double d) {
+			if (!std::isfinite(d))
+				fail("non-finite number");
+			return js_val{ d };
+		};
+		auto integer = [](uint64_t v) { return v <= INT64_MAX ? js_val{ js_int(v) } : js_val{ double(v) }; };
+		// (IEEE 754 "half" precision float, as used by CBOR)
+		auto half = [](uint64_t h) {
+			const int e(h >> 10 & 31), m(h & 1023);
+			const auto v{ e == 0 ? std::ldexp(m, -24) : e < 31 ? std::ldexp(m + 1024, e - 25)
+				: m ? std::numeric_limits<double>::quiet_NaN() : std::numeric_limits<double>::infinity() };
+			return h & 0x8000 ? -v : v;
+		};
+		// primary [iterative] decoder, with each open object or array a "frame" on
+		// an explicit stack, just as in parse above
+		struct frame {
+			js_val v; // (the open object or array)
+			js_str key; // (... the key of its NEXT member, if an object)
+			uint64_t left; // (members or elements still to come, unless open-ended)
+			bool open_ended; // (i.e., CBOR "indefinite length", ended by a "break")
+			bool keyed{}; // (has key been read?)
+		};
+		std::vector<frame> stack;
+		stack.reserve(32);
+		for (;;) {
+			// read the next item... a "simple" value (or string), the start of an
+			// object or array (of n members or elements), or [CBOR only] a "break"
+			enum { simple, object, array, stop } item{ simple };
+			js_val v{};
+			uint64_t n{};
+			bool open_ended{};
+			if (cbor) {
+				auto b{ byte() };
+				// (skip ANY "tags" preceding the item)
+				for (; b >> 5 == 6; b = byte())
+					if (const auto i{ b & 31 }; i >= 24)
+						i <= 27 ? void(uint(size_t(1) << (i - 24))) : fail("reserved value");
+				const auto m{ b >> 5 }, i{ b & 31 };
+				if (i == 31) {
+					if (m == 7)
+						item = stop;
+					else if (m == 2)
+						fail("byte strings NOT supported");
+					else if (m == 3) {
+						// (indefinite-length string, as "chunks" of the SAME major type)
+						js_str t(alloc);
+						for (uint8_t c; (c = byte()) != 0xff; )
+							if (const auto k{ c & 31 }; c >> 5 != m || k >= 28)
+								fail("bad string chunk");
+							else
+								bytes(t, k < 24 ? uint64_t(k) : uint(size_t(1) << (k - 24)));
+						v = text(std::move(t));
+					} else if (m == 4 || m == 5)
+						item = m == 5 ? object : array, open_ended = true;
+					else
+						fail("bad indefinite length");
+				} else {
+					if (i >= 28)
+						fail("reserved value");
+					const auto a{ i < 24 ? uint64_t(i) : uint(size_t(1) << (i - 24)) };
+					switch (m) {
+					case 0:
+						v = integer(a);
+						break;
+					case 1:
+						v = a <= INT64_MAX ? js_val{ -1 - js_int(a) } : js_val{ -1 - double(a) };
+						break;
+					case 2:
+						fail("byte strings NOT supported");
+						break;
+					case 3:
+						v = string(a);
+						break;
+					case 4:
+						item = array, n = a;
+						break;
+					case 5:
+						item = object, n = a;
+						break;
+					default:
+						// ("simple" values and floats)
+						if (i == 20 || i == 21)
+							v = js_val{ i == 21 };
+						else if (i == 25)
+							v = real(half(a));
+						else if (i == 26)
+							v = real(double(std::bit_cast<float>(uint32_t(a))));
+						else if (i == 27)
+							v = real(std::bit_cast<double>(a));
+						else if (i != 22 && i != 23)
+							fail("unsupported simple value");
+						// (N.B. - BOTH null and "undefined" are null)
+					}
+				}
+			} else if (const auto b{ byte() }; b <= 0x7f || b >= 0xe0)
+				v = js_int(int8_t(b));
+			else if (b <= 0x8f)
+				item = object, n = b & 15;
+			else if (b <= 0x9f)
+				item = array, n = b & 15;
+			else if (b <= 0xbf)
+				v = string(b & 31);
+			else
+				switch (b) {
+				case 0xc0:
+					break;
+				case 0xc2:
+				case 0xc3:
+					v = js_val{ b == 0xc3 };
+					break;
+				case 0xc4: // (bin 8, 16 and 32)
+				case 0xc5:
+				case 0xc6:
+					fail("byte strings NOT supported");
+					break;
+				case 0xca:
+					v = real(double(std::bit_cast<float>(uint32_t(uint(4)))));
+					break;
+				case 0xcb:
+					v = real(std::bit_cast<double>(uint(8)));
+					break;
+				case 0xcc:
+				case 0xcd:
+				case 0xce:
+				case 0xcf:
+					v = integer(uint(size_t(1) << (b - 0xcc)));
+					break;
+				case 0xd0:
+				case 0xd1:
+				case 0xd2:
+				case 0xd3: {
+					// (sign-extend the n-byte integer)
+					const auto k{ 64 - (8 << (b - 0xd0)) };
+					v = js_int(uint(size_t(1) << (b - 0xd0)) << k) >> k;
+					break;
+				}
+				case 0xd9:
+				case 0xda:
+				case 0xdb:
+					v = string(uint(size_t(1) << (b - 0xd9)));
+					break;
+				case 0xdc:
+				case 0xdd:
+					item = array, n = uint(b == 0xdc ? 2 : 4);
+					break;
+				case 0xde:
+				case 0xdf:
+					item = object, n = uint(b == 0xde ? 2 : 4);
+					break;
+				default:
+					fail("unsupported type");
+				}
+			if (item == stop && (stack.empty() || !stack.back().open_ended || stack.back().keyed))
+				fail("unexpected break");
+			if (item == object || item == array) {
+				if (opts.max_depth && stack.size() >= opts.max_depth)
+					fail("maximum depth exceeded");
+				stack.push_back({ item == object ? js_val{ js_obj(alloc) } : js_val{ js_arr(alloc) }, js_str(alloc), n, open_ended });
+				if (n || open_ended)
+					continue;
+			}
+			// an item is complete (or ends the innermost object or array)... add it
+			// to the innermost, which may then ITSELF be complete (and so on)
+			for (auto end{ item != simple }; ; end = true) {
+				if (end) {
+					auto& t{ stack.back() };
+					if (t.v.is_obj())
+						end_members(t.v.as_obj());
+					v = std::move(t.v);
+					stack.pop_back();
+				}
+				if (stack.empty())
+					return v;
+				auto& t{ stack.back() };
+				if (t.v.is_obj() && !t.keyed) {
+					if (!v.is_string())
+						fail("OBJECT: expected STRING key");
+					t.key = std::move(v.as_string()), t.keyed = true;
+					break;
+				}
+				if (t.v.is_obj())
+					add_member(t.v.as_obj(), std::move(t.key), std::move(v)), t.keyed = false;
+				else
+					t.v.as_arr().push_back(std::move(v));
+				if (t.open_ended || --t.left)
+					break;
+			}
+		}
+	}
+	static js_val parse_binary(std::string_view src, binary_format f, const parse_opts& opts = {}) {
+		detail::view_source s{ src };
+		auto v{ decode(s, f, opts) };
+		if (!s.s.empty())
+			throw std::runtime_error("Bad "s + (f == binary_format::cbor ? "CBOR" : "MessagePack")
+				+ " (unexpected data after value) @ " + std::to_string(src.size() - s.s.size()));
+		return v;
+	}
+
+	/*
+		Parse "newline-delimited" JSON text (aka NDJSON, or JSON Lines), in which
+		EACH line is a complete JSON text, returning the parsed js_vals in input
+		order (lines that are empty, or only whitespace, are simply skipped).
+
+		Each line is parsed by parse() above, but the text is first split into as
+		many "parts" (of whole lines) as there are threads to be used - see the
+		parse_opts threads option - and the parts are then parsed in parallel.
+
+		If any line is badly-formed, the std::runtime_error exception thrown by
+		parse() is rethrown (from the calling thread) with the offending line's
+		[1-based] number added... and if there are several, it is for the FIRST.
+	*/
+	static std::vector<js_val> parse_lines(std::string_view src, const parse_opts& opts = {}) {
+		std::vector<std::vector<js_val>> parts;
+		each_line(src, opts,
+			[&](size_t n) { parts.resize(n); },
+			[&](size_t k, size_t, js_val&& v) { parts[k].push_back(std::move(v)); });
+		if (parts.size() == 1)
+			return std::move(parts[0]);
+		std::vector<js_val> o;
+		size_t n{};
+		for (const auto& p : parts)
+			n += p.size();
+		o.reserve(n);
+		for (auto& p : parts)
+			std::move(p.begin(), p.end(), std::back_inserter(o));
+		return o;
+	}
+	// ... or deliver each parsed js_val (and its line number) to a "callback"
+	// N.B. - f is called from ALL of the threads parsing the text, concurrently,
+	// so it MUST be thread-safe... and lines are in order only WITHIN each part
+	template<std::invocable<size_t, js_val&&> F>
+	static void parse_lines(std::string_view src, F&& f, const parse_opts& opts = {}) {
+		each_line(src, opts, [](size_t) {}, [&](size_t, size_t line, js_val&& v) { f(line, std::move(v)); });
+	}
+
+private:
+	// split src into parts of whole lines, then parse ALL lines, part-by-part
+	template<class Init, class Emit>
+	static void each_line(std::string_view src, const parse_opts& opts, Init&& init, Emit&& emit) {
+#ifdef NO_THREADS
+		const size_t n{ 1 };
+#else
+		// (no part is smaller than this, so small texts don't need threads at all)
+		constexpr size_t min_part{ 1 << 16 };
+		const size_t threads{ opts.threads ? opts.threads : std::max(std::thread::hardware_concurrency(), 1u) };
+		const size_t n{ std::clamp(src.size() / min_part, size_t(1), threads) };
+#endif
+		init(n);
+		// (part k is [cut[k], cut[k + 1]), each part ending just after a '\n')
+		std::vector<size_t> cut(n + 1, src.size());
+		cut[0] = 0;
+		for (size_t k = 1; k < n; ++k)
+			if (const auto e{ src.find('\n', std::max(k * (src.size() / n), cut[k - 1])) }; e != src.npos)
+				cut[k] = e + 1;
+		std::vector<size_t> lines(n); // (count of '\n's in each part)
+		std::vector<std::exception_ptr> errs(n);
+#ifndef NO_THREADS
+		std::latch counted{ ptrdiff_t(n) };
+		std::atomic<size_t> failed{ n }; // (earliest part to fail, so far)
+#endif
+		auto run = [&](size_t k) {
+			try {
+				// number the lines of this part, which means counting ALL earlier ones
+				lines[k] = size_t(std::count(src.begin() + cut[k], src.begin() + cut[k + 1], '\n'));
+				auto line{ size_t(1) };
+#ifndef NO_THREADS
+				counted.arrive_and_wait();
+#endif
+				for (size_t j = 0; j < k; ++j)
+					line += lines[j];
+				for (auto b{ cut[k] }; b < cut[k + 1]; ++line) {
+#ifndef NO_THREADS
+					// (no point in going on, if an EARLIER part has already failed)
+					if (failed.load(std::memory_order_relaxed) < k)
+						return;
+#endif
+					const auto e{ std::min(src.find('\n', b), cut[k + 1]) };
+					const auto t{ src.substr(b, e - b) };
+					b = e + 1;
+					if (t.find_first_not_of(" \t\r") == t.npos)
+						continue;
+					js_val v;
+					try {
+						v = parse(t, opts);
+					} catch (const std::runtime_error& x) {
+						throw std::runtime_error(x.what() + ", on line "s + std::to_string(line));
+					}
+					emit(k, line, std::move(v));
+				}
+			} catch (...) {
+				errs[k] = std::current_exception();
+#ifndef NO_THREADS
+				for (auto f{ failed.load() }; k < f && !failed.compare_exchange_weak(f, k); ) ;
+#endif
+			}
+		};
+#ifdef NO_THREADS
+		run(0);
+#else
+		{
+			std::vector<std::jthread> pool;
+			pool.reserve(n - 1);
+			try {
+				for (size_t k = 1; k < n; ++k)
+					pool.emplace_back(run, k);
+			} catch (...) {
+				// (release any threads that were started, THEN give up)
+				counted.count_down(ptrdiff_t(n - pool.size()));
+				throw;
+			}
+			// (the calling thread parses the first part itself)
+			run(0);
+		} // (N.B. - std::jthreads join on destruction)
+#endif
+		for (const auto& e : errs)
+			if (e)
+				std::rethrow_exception(e);
+	}
+};
+
+/*
+	js_hashed is a js_val together with its [deep] hash (see js_val::hash), which
+	is computed just ONCE - making it a good key for unordered containers, e.g.,
+	to "dedupe" values, as comparing two js_hasheds for equality compares their
+	hashes FIRST, and only compares the values themselves if those are equal.
+
+	The value may be read, but NOT changed (which would make the hash stale).
+*/
+class js_hashed {
+	js_val v;
+	size_t h;
+
+public:
+	explicit js_hashed(js_val v) noexcept : v(std::move(v)), h(this->v.hash()) {}
+
+	inline const js_val& get() const noexcept { return v; }
+	inline const js_val& operator*() const noexcept { return v; }
+	inline const js_val* operator->() const noexcept { return &v; }
+	inline size_t hash() const noexcept { return h; }
+
+	bool operator==(const js_hashed& u) const { return h == u.h && v == u.v; }
+	// ... and, more simply, to ANY js_val
+	bool operator==(const js_val& u) const { return v == u; }
+};
+
+#ifdef USE_PMR
+/*
+	js_doc is a parsed JSON "document" whose ENTIRE js_val tree - every node,
+	string and container - is allocated from its own "bump" allocator arena (a
+	std::pmr::monotonic_buffer_resource)... so that parsing performs only a few
+	[large] allocations, and destroying the document releases the whole tree at
+	once, WITHOUT visiting (or running the dtors of) any of its nodes.
+
+	The tree is READ-ONLY - ONLY a const js_val& to its root is given out, and a
+	const js_val can NOT be changed (N.B. - anything assigned into it would NOT
+	come from the arena, and so, with no dtors run, would leak) - but a *copy* of
+	any part of it is an ordinary js_val using the default memory resource, and
+	as such can be modified, and can safely outlive the js_doc.
+*/
+class js_doc {
+	std::pmr::monotonic_buffer_resource arena;
+	const js_val* root; // (N.B. - constructed IN the arena, and NEVER destroyed)
+
+public:
+	// parse src into a new js_doc, whose arena starts out sized based on src
+	explicit js_doc(std::string_view src, parse_opts opts = {},
+		std::pmr::memory_resource* upstream = std::pmr::get_default_resource()) :
+		arena{ std::max(src.size(), size_t(1024)), upstream } {
+		opts.mr = &arena;
+		root = new (arena.allocate(sizeof(js_val), alignof(js_val))) js_val{ js_val::parse(src, opts) };
+	}
+	js_doc(const js_doc&) = delete;
+	js_doc& operator=(const js_doc&) = delete;
+
+	inline const js_val& get() const noexcept { return *root; }
+	inline const js_val& operator*() const noexcept { return *root; }
+	inline const js_val* operator->() const noexcept { return root; }
+};
+#endif
+
+class js_lazy;
+
+/*
+	js_lazy_doc is a "lazily" parsed JSON document... parsing it checks ALL of
+	the JSON text exactly as js_val::parse does, but instead of building a tree
+	of js_vals, it only records a compact "tape" of the document's structure (a
+	few 64-bit words per value, giving offsets into the JSON text).  No strings
+	are decoded and no numbers converted until they are actually reached - see
+	js_lazy, whose accessors mirror those of js_val - which makes it ideal when
+	only a handful of values are wanted out of a [large] document.
+
+	N.B. - the JSON text is NOT copied, so it MUST outlive the js_lazy_doc (and
+	every js_lazy obtained from it).
+*/
+class js_lazy_doc {
+	friend class js_lazy;
+
+	// each tape entry is a tag (in the top 8 bits) and a 56-bit "payload"...
+	// strings and numbers take TWO entries: their offset, and then their length
+	enum class tag : uint8_t {
+		null, false_, true_, number, string, escaped_string,
+		obj_start, obj_end, arr_start, arr_end };
+	static constexpr uint64_t entry(tag t, size_t v) noexcept { return uint64_t(t) << 56 | v; }
+	constexpr tag type(size_t i) const noexcept { return tag(tape[i] >> 56); }
+	constexpr size_t payload(size_t i) const noexcept { return size_t(tape[i] & ((uint64_t(1) << 56) - 1)); }
+	// (index of the tape entry FOLLOWING the value starting at i)
+	constexpr size_t skip(size_t i) const noexcept {
+		switch (type(i)) {
+		case tag::number: case tag::string: case tag::escaped_string:
+			return i + 2;
+		case tag::obj_start: case tag::arr_start:
+			return payload(i);
+		default:
+			return i + 1;
+		}
+	}
+	// (the "raw" text of string or number at i, EXCLUDING any quotes)
+	constexpr std::string_view raw(size_t i) const noexcept { return src.substr(payload(i), payload(i + 1)); }
+
+	std::string_view src;
+	std::vector<uint64_t> tape;
+
+public:
+	explicit js_lazy_doc(std::string_view src, const parse_opts& opts = {}) : src(src) {
+		using enum js_val::parse_state;
+		js_val::lexer lx{ src, opts };
+		auto& co{ lx.co };
+		tape.reserve(src.size() / 8 + 2);
+		auto string = [&]() {
+			const auto start{ co + 1 };
+			detail::check_sink o;
+			lx.string(o);
+			tape.push_back(entry(o.escaped ? tag::escaped_string : tag::string, start));
+			tape.push_back(co - 1 - start);
+		};
+		// primary [iterative] parser, recording ONLY the tape... the open objects
+		// and arrays are kept on an explicit stack (of their start entry's index,
+		// and their member count so far), just as in js_val::parse
+		struct open {
+			size_t at, n;
+		};
+		std::vector<open> stack;
+		auto t{ lx.next() };
+		for (;;) {
+			// t MUST begin a value, either "simple", or an object or array
+			switch (t) {
+			case in_string:
+				string();
+				break;
+			case in_number: {
+				const auto start{ lx.skip_number() };
+				tape.push_back(entry(tag::number, start));
+				tape.push_back(co - start);
+				break;
+			}
+			case in_keyword:
+				if (const auto k{ lx.keyword() }; k.is_null())
+					tape.push_back(entry(tag::null, 0));
+				else
+					tape.push_back(entry(k.as_bool() ? tag::true_ : tag::false_, 0));
+				break;
+			case in_object:
+			case in_array:
+				if (opts.max_depth && stack.size() >= opts.max_depth)
+					throw std::runtime_error("Bad parse (maximum depth exceeded) @ "s + std::to_string(co));
+				// (the start entry gets the index PAST the end entry, which gets the size)
+				stack.push_back({ tape.size(), 0 });
+				if (tape.push_back(entry(t == in_object ? tag::obj_start : tag::arr_start, 0)); t == in_object) {
+					// check for [and ALLOW] "empty" object
+					if (++co, t = lx.next(); t != end_object) {
+						if (t != in_string)
+							throw std::runtime_error("Bad parse (OBJECT: expected STRING) @ "s + std::to_string(co));
+						string();
+						if (lx.next() != obj_colon)
+							throw std::runtime_error("Bad parse (OBJECT: expected ':') @ "s + std::to_string(co));
+						++co, t = lx.next();
+						continue;
+					}
+				} else if (++co, t = lx.next(); t != end_array)
+					// (... and ALLOW "empty" array)
+					continue;
+				break;
+			default:
+				// we MUST see a VALUE!
+				throw std::runtime_error("Bad parse (expected VALUE) @ "s + std::to_string(co));
+			}
+			// a value is complete... see what follows it in the innermost object or
+			// array, which may then ITSELF be complete (and so on)
+			for (;;) {
+				if (t == end_object || t == end_array) {
+					++co; // (consume '}' or ']')
+					const auto [at, n] { stack.back() };
+					const auto obj{ type(at) == tag::obj_start };
+					stack.pop_back();
+					tape.push_back(entry(obj ? tag::obj_end : tag::arr_end, n));
+					tape[at] = entry(obj ? tag::obj_start : tag::arr_start, tape.size());
+				}
+				if (stack.empty())
+					return;
+				const auto obj{ type(stack.back().at) == tag::obj_start };
+				if (++stack.back().n, t = lx.next(); t == more_items) {
+					if (++co, t = lx.next(); obj) {
+						if (t != in_string)
+							throw std::runtime_error("Bad parse (OBJECT: expected STRING) @ "s + std::to_string(co));
+						string();
+						if (lx.next() != obj_colon)
+							throw std::runtime_error("Bad parse (OBJECT: expected ':') @ "s + std::to_string(co));
+						++co, t = lx.next();
+					}
+					break;
+				}
+				if (obj && t != end_object)
+					throw std::runtime_error("Bad parse (OBJECT: expected ',' or '}') @ "s + std::to_string(co));
+				if (!obj && t != end_array)
+					throw std::runtime_error("Bad parse (ARRAY: expected ',' or ']') @ "s + std::to_string(co));
+			}
+		}
+	}
+
+	// the [lazy] "root" value of the document
+	js_lazy root() const noexcept;
+};
+
+/*
+	js_lazy is a [lightweight, freely copyable] reference to a value in a lazily
+	parsed js_lazy_doc, with accessors like those of js_val... strings and numbers
+	are decoded / converted each time they're asked for, and "stepping into" an
+	object or array (via operator[]) simply skips over everything else.
+
+	As with js_val, asking for the wrong type throws std::bad_variant_access...
+	while a key or index NOT present in an object or array (respectively) throws
+	std::out_of_range.  And get() "materializes" the value as an actual js_val.
+*/
+class js_lazy {
+	friend class js_lazy_doc;
+	using tag = js_lazy_doc::tag;
+
+	const js_lazy_doc* d;
+	size_t i;
+
+	constexpr js_lazy(const js_lazy_doc* d, size_t i) noexcept : d(d), i(i) {}
+	constexpr tag type() const noexcept { return d->type(i); }
+	constexpr void expect(bool ok) const {
+		if (!ok)
+			throw std::bad_variant_access();
+	}
+	// (compare a key [at tape index k] with s, decoding it ONLY if necessary)
+	bool key_is(size_t k, std::string_view s) const {
+		if (d->type(k) == tag::string)
+			return d->raw(k) == s;
+		return js_lazy{ d, k }.as_string() == s;
+	}
+	// (read a number EXACTLY as js_val::parse does, i.e., maybe as an integer)
+	js_val number() const {
+		expect(is_num());
+		js_val::lexer lx{ d->raw(i), d->payload(i) };
+		return lx.number([](auto n) { return js_val{ n }; });
+	}
+	// (tape index of value for key s, or 0 if NOT present... FIRST key wins)
+	size_t find(std::string_view s) const {
+		expect(is_obj());
+		for (auto k{ i + 1 }; d->type(k) != tag::obj_end; k = d->skip(k + 2))
+			if (key_is(k, s))
+				return k + 2;
+		return 0;
+	}
+
+public:
+	// query the type of the referenced value
+	constexpr bool is_null() const noexcept { return type() == tag::null; }
+	constexpr bool is_bool() const noexcept { return type() == tag::false_ || type() == tag::true_; }
+	constexpr bool is_num() const noexcept { return type() == tag::number; }
+	constexpr bool is_string() const noexcept { return type() == tag::string || type() == tag::escaped_string; }
+	constexpr bool is_obj() const noexcept { return type() == tag::obj_start; }
+	constexpr bool is_arr() const noexcept { return type() == tag::arr_start; }
+
+	// return the referenced value, decoded (and "copied out") as requested
+	constexpr nullptr_t as_null() const { return expect(is_null()), nullptr; }
+	constexpr bool as_bool() const { return expect(is_bool()), type() == tag::true_; }
+	double as_num() const { return number().as_num(); }
+	js_int as_int() const { return number().as_int(); }
+	// (N.B. - unlike the other is_*, this has to [re-]read the number's text)
+	bool is_int() const { return is_num() && number().is_int(); }
+	js_str as_string() const {
+		expect(is_string());
+		if (type() == tag::string)
+			return js_str{ d->raw(i) };
+		// (escaped strings are decoded by the lexer, starting at the opening '"')
+		const auto at{ d->payload(i) - 1 };
+		js_val::lexer lx{ d->src.substr(at, d->payload(i + 1) + 2), at };
+		js_str o;
+		lx.string(o);
+		return o;
+	}
+
+	// number of members (or elements) of a referenced object (or array)
+	size_t size() const {
+		expect(is_obj() || is_arr());
+		return d->payload(d->payload(i) - 1);
+	}
+	bool contains(std::string_view s) const { return find(s) != 0; }
+
+	// "step into" the referenced object or array
+	js_lazy operator[](std::string_view s) const {
+		if (const auto k{ find(s) }; k)
+			return { d, k };
+		throw std::out_of_range("js_lazy: key not found");
+	}
+	js_lazy operator[](std::integral auto n) const {
+		expect(is_arr());
+		auto k{ i + 1 };
+		for (; n > 0 && d->type(k) != tag::arr_end; --n)
+			k = d->skip(k);
+		if (n < 0 || d->type(k) == tag::arr_end)
+			throw std::out_of_range("js_lazy: index out of range");
+		return { d, k };
+	}
+
+	// "materialize" the ENTIRE referenced value (and all it contains) as a js_val
+	js_val get() const {
+		switch (type()) {
+		case tag::null:
+			return nullptr;
+		case tag::false_:
+		case tag::true_:
+			return as_bool();
+		case tag::number:
+			return number();
+		case tag::string:
+		case tag::escaped_string:
+			return as_string();
+		case tag::obj_start: {
+			js_val v{ js_obj{} };
+			auto& m{ v.as_obj() };
+			for (auto k{ i + 1 }; d->type(k) != tag::obj_end; k = d->skip(k + 2))
+				detail::add_member(m, js_lazy{ d, k }.as_string(), js_lazy{ d, k + 2 }.get());
+			detail::end_members(m);
+			return v;
+		}
+		default: {
+			js_val v{ js_arr{} };
+			auto& a{ v.as_arr() };
+			a.reserve(size());
+			for (auto k{ i + 1 }; d->type(k) != tag::arr_end; k = d->skip(k))
+				a.push_back(js_lazy{ d, k }.get());
+			return v;
+		}
+		}
+	}
+};
+
+inline js_lazy js_lazy_doc::root() const noexcept { return { this, 0 }; }
+
+/*
+	js_path is a "compiled" query, selecting values within a js_val... compile it
+	just once (parsing and checking the text of the query, and decoding any keys),
+	then run it against as many js_vals as needed - running it NEVER allocates,
+	NEVER inserts anything (unlike js_val::operator[]), and looks keys up using
+	std::string_views (so NO temporary strings are created).
+
+	Two query syntaxes are accepted:
+	- an RFC 6901 "JSON Pointer", i.e., "" (the whole value) or "/"-separated
+	reference tokens like "/a/4/ab" (with "~1" and "~0" escaping '/' and '~')
+	- a [simple] "path expression" starting with "$", followed by any of:
+	  .name or ['name'] or ["name"]    - member of an object
+	  [n]                              - element of an array
+	  .* or [*]                        - ALL members or elements (a "wildcard")
+	  ..                               - the value, and ALL values within it (so,
+	                                     e.g., "$..id" finds EVERY "id" member)
+
+	N.B. - a query having a wildcard (or "..") may select any number of values...
+	find (and get) return just the first of these (in document order), while
+	for_each (and select) deliver them all.
+*/
+class js_path {
+	// each "step" of a query selects [zero or more] values within each value
+	// selected by the previous step (with the root value "selected" initially)
+	struct step {
+		enum kind : uint8_t { name, index, any, descend } k;
+		std::string key;	// (name)
+		size_t i{ std::string::npos };	// (index, AND name if from a JSON Pointer)
+	};
+	std::vector<step> steps;
+
+	friend class js_cached_doc;
+	friend class js_patch;
+
+	// apply steps [s..] to v, calling f(V&) for EVERY selected value... stopping
+	// if f returns false (and then returning false ourselves)
+	// N.B. - given a trail, the objects and arrays containing the value passed to
+	// f (from the outermost in) are ALSO kept there, as the walk proceeds
+	template<class V, class F>
+	bool walk(V& v, size_t s, F& f, std::vector<V*>* trail = nullptr) const {
+		if (s == steps.size())
+			return f(v);
+		const auto& t{ steps[s] };
+		// (apply steps [n..] to c, a value IN v)
+		auto into = [&](V& c, size_t n) {
+			if (!trail)
+				return walk<V>(c, n, f);
+			trail->push_back(&v);
+			const auto r{ walk<V>(c, n, f, trail) };
+			trail->pop_back();
+			return r;
+		};
+		switch (t.k) {
+		case step::name:
+			if (v.is_obj()) {
+				auto& m{ v.as_obj() };
+				if (const auto i{ m.find(std::string_view{ t.key }) }; i != m.end())
+					return into(i->second, s + 1);
+				return true;
+			}
+			[[fallthrough]];
+		case step::index:
+			if (v.is_arr() && t.i < v.as_arr().size())
+				return into(v.as_arr()[t.i], s + 1);
+			return true;
+		case step::any:
+			if (v.is_obj())
+				for (auto& [_, c] : v.as_obj())
+					if (!into(c, s + 1))
+						return false;
+			if (v.is_arr())
+				for (auto& c : v.as_arr())
+					if (!into(c, s + 1))
+						return false;
+			return true;
+		default: // descend
+			if (!walk(v, s + 1, f, trail))
+				return false;
+			if (v.is_obj())
+				for (auto& [_, c] : v.as_obj())
+					if (!into(c, s))
+						return false;
+			if (v.is_arr())
+				for (auto& c : v.as_arr())
+					if (!into(c, s))
+						return false;
+			return true;
+		}
+	}
+
+	[[noreturn]] static void bad(const char* what, size_t co) {
+		throw std::runtime_error("Bad path ("s + what + ") @ " + std::to_string(co));
+	}
+	// (RFC 6901 array index, i.e., digits with NO leading zero... else npos)
+	static size_t to_index(std::string_view t) noexcept {
+		size_t i{};
+		if (t.empty() || (t[0] == '0' && t.size() > 1) ||
+			std::from_chars(t.data(), t.data() + t.size(), i).ptr != t.data() + t.size())
+			return std::string::npos;
+		return i;
+	}
+	void pointer(std::string_view p) {
+		if (p.empty())
+			return;
+		if (p[0] != '/')
+			bad("expected '/'", 0);
+		for (size_t co{ 1 };; ++co) {
+			auto& t{ steps.emplace_back(step::name) };
+			for (; co < p.size() && p[co] != '/'; ++co)
+				if (p[co] != '~')
+					t.key += p[co];
+				else if (++co < p.size() && (p[co] == '0' || p[co] == '1'))
+					t.key += p[co] == '0' ? '~' : '/';
+				else
+					bad("expected '~0' or '~1'", co - 1);
+			t.i = to_index(t.key);
+			if (co >= p.size())
+				break;
+		}
+	}
+	void expression(std::string_view p) {
+		size_t co{ 1 };
+		// ['name'] or ["name"], [n], or [*]
+		auto bracket = [&]() {
+			if (++co >= p.size())
+				bad("expected NAME, INDEX or '*'", co);
+			if (const auto q{ p[co] }; q == '\'' || q == '"') {
+				auto& t{ steps.emplace_back(step::name) };
+				for (++co; co < p.size() && p[co] != q; ++co)
+					if (p[co] != '\\')
+						t.key += p[co];
+					else if (++co < p.size())
+						t.key += p[co];
+				if (co++ >= p.size())
+					bad("unterminated NAME", co - 1);
+			} else if (q == '*')
+				steps.emplace_back(step::any), ++co;
+			else {
+				const auto start{ co };
+				while (co < p.size() && detail::isdigit(p[co]))
+					++co;
+				if (const auto i{ to_index(p.substr(start, co - start)) }; i != std::string::npos)
+					steps.emplace_back(step::index, std::string{}, i);
+				else
+					bad("expected NAME, INDEX or '*'", start);
+			}
+			if (co >= p.size() || p[co] != ']')
+				bad("expected ']'", co);
+			++co;
+		};
+		// name or *
+		auto dotted = [&]() {
+			if (co < p.size() && p[co] == '*')
+				steps.emplace_back(step::any), ++co;
+			else {
+				const auto start{ co };
+				while (co < p.size() && p[co] != '.' && p[co] != '[')
+					++co;
+				if (co == start)
+					bad("expected NAME or '*'", co);
+				steps.emplace_back(step::name, std::string{ p.substr(start, co - start) });
+			}
+		};
+		while (co < p.size())
+			if (p[co] == '[')
+				bracket();
+			else if (p[co] != '.')
+				bad("expected '.' or '['", co);
+			else if (++co < p.size() && p[co] == '.') {
+				steps.emplace_back(step::descend);
+				if (++co < p.size() && p[co] == '[')
+					bracket();
+				else
+					dotted();
+			} else
+				dotted();
+	}
+
+public:
+	// compile a JSON Pointer or path expression (see above), throwing a
+	// std::runtime_error (giving the offset of the problem) if malformed
+	explicit js_path(std::string_view p) {
+		if (!p.empty() && p[0] == '$')
+			expression(p);
+		else
+			pointer(p);
+	}
+
+	// return [pointer to] the FIRST value selected in v, or nullptr if none is
+	template<class V>
+		requires std::same_as<std::remove_const_t<V>, js_val>
+	V* find(V& v) const {
+		V* r{};
+		auto f = [&](V& u) { return r = &u, false; };
+		walk(v, 0, f);
+		return r;
+	}
+	// ... or a reference to it, throwing std::out_of_range if none is
+	template<class V>
+		requires std::same_as<std::remove_const_t<V>, js_val>
+	V& get(V& v) const {
+		if (const auto r{ find(v) })
+			return *r;
+		throw std::out_of_range("js_path: no value selected");
+	}
+	bool contains(const js_val& v) const { return find(v) != nullptr; }
+
+	// call f(js_val&) (or f(const js_val&)) for EVERY value selected in v, in
+	// document order (N.B. - "document order" is key order for js_obj members)
+	template<class V, class F>
+		requires std::same_as<std::remove_const_t<V>, js_val>
+	void for_each(V& v, F&& f) const {
+		auto g = [&](V& u) { return f(u), true; };
+		walk(v, 0, g);
+	}
+	// ... or append [pointers to] them to out (reusing its capacity), returning
+	// the number of values selected
+	size_t select(const js_val& v, std::vector<const js_val*>& out) const {
+		const auto n{ out.size() };
+		for_each(v, [&](const js_val& u) { out.push_back(&u); });
+		return out.size() - n;
+	}
+	size_t count(const js_val& v) const {
+		size_t n{};
+		for_each(v, [&](const js_val&) { ++n; });
+		return n;
+	}
+};
+
+/*
+	js_cached_doc holds a js_val whose serialized text is CACHED... after [small]
+	changes, to_string copies the text of every object and array that has NOT
+	changed straight from its previous result, and re-serializes ONLY what has
+	changed (i.e., the changed values, and the objects and arrays containing them).
+
+	To make this possible, ALL changes are made through edit, which calls f(js_val&)
+	for each value selected by a js_path (just as js_path::for_each does), having
+	first marked it - and its "ancestors" - as changed... f may then change that
+	value (and anything in it) as it likes, but NOTHING else... while get() and
+	operator* give ONLY a const js_val, whose as_obj() and operator[] can NOT
+	change it (see js_val), so that the cache is NEVER silently out of date.
+
+	The cache records, for every object and array, where its text is (relative to
+	that of the object or array containing it), so the text of an unchanged one
+	is found without visiting anything inside it.
+
+	N.B. - values are tracked by ADDRESS, so a js_cached_doc can't be copied or moved
+*/
+class js_cached_doc {
+	js_val v;
+	std::string text; // (the LAST result of to_string)
+	std::string next; // (... and the buffer for the next, re-used to avoid allocating)
+	bool pass_thru{};
+	// (where the text of each object or array is: at its offset from the start of
+	// its container's text, n chars... and whether it's changed since)
+	struct span {
+		size_t at, n;
+		bool dirty;
+	};
+	std::unordered_map<const js_val*, span> spans;
+
+	// (forget the spans of v, and of ALL objects and arrays in it)
+	void forget(const js_val& u) {
+		if (u.is_obj()) {
+			spans.erase(&u);
+			for (const auto& [_, c] : u.as_obj())
+				forget(c);
+		} else if (u.is_arr()) {
+			spans.erase(&u);
+			for (const auto& c : u.as_arr())
+				forget(c);
+		}
+	}
+	// (append the text of u to o, where old is the offset of its container's text
+	// in the LAST result, and at is that in the new one)
+	void emit(const js_val& u, std::string& o, size_t old, size_t at) {
+		if (!u.is_obj() && !u.is_arr()) {
+			u.stringify(o, pass_thru);
+			return;
+		}
+		// (N.B. - an object or array NOT seen before is, of course, "changed")
+		auto& s{ spans.try_emplace(&u, span{ 0, 0, true }).first->second };
+		const auto start{ o.size() }, prev{ old + s.at };
+		if (s.at = start - at; !s.dirty) {
+			o.append(text, prev, s.n);
+			return;
+		}
+		if (u.is_obj()) {
+			o.push_back('{');
+			bool first{ true };
+			for (const auto& [key, val] : u.as_obj()) {
+				if (!first)
+					o.push_back(',');
+				first = false;
+				detail::stringify_string(o, key, pass_thru);
+				o.push_back(':');
+				emit(val, o, prev, start);
+			}
+			o.push_back('}');
+		} else {
+			o.push_back('[');
+			bool first{ true };
+			for (const auto& e : u.as_arr()) {
+				if (!first)
+					o.push_back(',');
+				first = false;
+				emit(e, o, prev, start);
+			}
+			o.push_back(']');
+		}
+		s.n = o.size() - start, s.dirty = false;
+	}
+
+public:
+	explicit js_cached_doc(js_val v = {}) : v(std::move(v)) {}
+	js_cached_doc(const js_cached_doc&) = delete;
+	js_cached_doc& operator=(const js_cached_doc&) = delete;
+
+	inline const js_val& get() const noexcept { return v; }
+	inline const js_val& operator*() const noexcept { return v; }
+	inline const js_val* operator->() const noexcept { return &v; }
+
+	// call f(js_val&) for EVERY value selected by p (see above), returning the
+	// number of values selected (N.B. - js_path{ "" } selects the WHOLE value)
+	template<std::invocable<js_val&> F>
+	size_t edit(const js_path& p, F&& f) {
+		size_t n{};
+		std::vector<js_val*> trail;
+		auto g = [&](js_val& u) {
+			// (once a container is marked, so are ALL those containing it)
+			for (auto i{ trail.rbegin() }; i != trail.rend(); ++i)
+				if (auto s{ spans.find(*i) }; s == spans.end() || s->second.dirty)
+					break;
+				else
+					s->second.dirty = true;
+			forget(u);
+			f(u);
+			return ++n, true;
+		};
+		p.walk(v, 0, g, &trail);
+		return n;
+	}
+
+	// serialize the value, exactly as js_val::to_string does... BUT re-using the
+	// text of everything unchanged since the last call (with the same pass_thru)
+	const std::string& to_string(bool pass_thru = false) {
+		if (pass_thru != this->pass_thru)
+			spans.clear(), this->pass_thru = pass_thru;
+		if (const auto s{ spans.find(&v) }; s != spans.end() && !s->second.dirty)
+			return text;
+		next.clear();
+		emit(v, next, 0, 0);
+		text.swap(next);
+		return text;
+	}
+};
+
+/*
+	js_patch computes and applies JSON Patches (RFC 6902), i.e., arrays of "add",
+	"remove", "replace", "move", "copy" and "test" operations on the values found
+	at JSON Pointers (see js_path), and applies JSON Merge Patches (RFC 7396)...
+	so that a change to a [large] document can be sent as just a "delta".
+
+	Patches are applied IN PLACE, with NOTHING outside the values they change
+	rebuilt or copied ("move" moves its value, and ONLY "copy" copies one)... but
+	N.B. - a patch failing part way is NOT undone, so apply it to a copy of the
+	document if it must be "all or nothing".
+*/
+class js_patch {
+	// (append the JSON Pointer "reference token" for key k to p)
+	static void token(std::string& p, std::string_view k) {
+		p.push_back('/');
+		for (const auto c : k)
+			if (c == '~')
+				p += "~0";
+			else if (c == '/')
+				p += "~1";
+			else
+				p.push_back(c);
+	}
+	static js_val op(const char* o, const std::string& path, const js_val* v = nullptr) {
+		js_val r{ js_obj{} };
+		r["op"] = js_val{ o };
+		r["path"] = js_val{ path };
+		if (v)
+			r["value"] = *v;
+		return r;
+	}
+	// (append to ops what changes a to b, both at path)
+	static void diff(const js_val& a, const js_val& b, std::string& path, js_val& ops) {
+		const auto n{ path.size() };
+		if (a.is_obj() && b.is_obj()) {
+			const auto& x{ a.as_obj() };
+			const auto& y{ b.as_obj() };
+#ifdef USE_ORDERED_MAP
+			// (members are in insertion order, so look each key up in the other)
+			for (const auto& [k, u] : x) {
+				token(path, k);
+				if (const auto j{ y.find(std::string_view{ k }) }; j == y.end())
+					ops.as_arr().push_back(op("remove", path));
+				else
+					diff(u, j->second, path, ops);
+				path.resize(n);
+			}
+			for (const auto& [k, u] : y)
+				if (!x.contains(std::string_view{ k }))
+					token(path, k), ops.as_arr().push_back(op("add", path, &u)), path.resize(n);
+#else
+			// (members are in key order, so "merge" the two in a single pass)
+			auto i{ x.begin() };
+			auto j{ y.begin() };
+			while (i != x.end() || j != y.end()) {
+				const auto c{ i == x.end() ? 1 : j == y.end() ? -1 : std::string_view{ i->first }.compare(j->first) };
+				if (c < 0)
+					token(path, i->first), ops.as_arr().push_back(op("remove", path)), ++i;
+				else if (c > 0)
+					token(path, j->first), ops.as_arr().push_back(op("add", path, &j->second)), ++j;
+				else
+					token(path, i->first), diff(i->second, j->second, path, ops), ++i, ++j;
+				path.resize(n);
+			}
+#endif
+		} else if (a.is_arr() && b.is_arr()) {
+			// (skip any elements equal at the start and end, then change elements
+			// in place, and add or remove the rest... so a single insertion or
+			// removal is just ONE operation)
+			const auto& x{ a.as_arr() };
+			const auto& y{ b.as_arr() };
+			size_t p{}, s{};
+			while (p < x.size() && p < y.size() && x[p] == y[p])
+				++p;
+			while (s < x.size() - p && s < y.size() - p && x[x.size() - 1 - s] == y[y.size() - 1 - s])
+				++s;
+			const auto m{ std::min(x.size(), y.size()) - p - s };
+			auto at = [&](size_t i) { path.resize(n), token(path, std::to_string(i)); };
+			for (size_t i{}; i < m; ++i)
+				at(p + i), diff(x[p + i], y[p + i], path, ops);
+			for (auto i{ p + m }; i < x.size() - s; ++i)
+				at(p + m), ops.as_arr().push_back(op("remove", path));
+			for (auto i{ p + m }; i < y.size() - s; ++i)
+				at(i), ops.as_arr().push_back(op("add", path, &y[i]));
+			path.resize(n);
+		} else if (!(a == b))
+			ops.as_arr().push_back(op("replace", path, &b));
+	}
+
+	[[noreturn]] static void bad(const char* what, size_t n) {
+		throw std::runtime_error("Bad patch ("s + what + ") @ " + std::to_string(n));
+	}
+	// (compile p, which MUST be a JSON Pointer, reporting ANY error as a bad patch)
+	static js_path pointer(std::string_view p, size_t n) {
+		if (!p.empty() && p[0] != '/')
+			bad("expected a JSON Pointer", n);
+		try {
+			return js_path{ p };
+		} catch (std::runtime_error& e) {
+			bad(e.what(), n);
+		}
+	}
+	// (the value at ALL but the last step of p, i.e., that containing p's value)
+	static js_val& parent(js_val& doc, const js_path& p, size_t n) {
+		auto v{ &doc };
+		for (size_t s{}; s + 1 < p.steps.size(); ++s)
+			if (const auto& t{ p.steps[s] }; v->is_obj()) {
+				auto& m{ v->as_obj() };
+				if (const auto i{ m.find(std::string_view{ t.key }) }; i != m.end())
+					v = &i->second;
+				else
+					bad("path NOT found", n);
+			} else if (v->is_arr() && t.i < v->as_arr().size())
+				v = &v->as_arr()[t.i];
+			else
+				bad("path NOT found", n);
+		return *v;
+	}
+	// (the value at p, or nullptr if none)
+	static js_val* find(js_val& doc, const js_path& p, size_t n) {
+		if (p.steps.empty())
+			return &doc;
+		auto& v{ parent(doc, p, n) };
+		const auto& t{ p.steps.back() };
+		if (v.is_obj()) {
+			auto& m{ v.as_obj() };
+			const auto i{ m.find(std::string_view{ t.key }) };
+			return i != m.end() ? &i->second : nullptr;
+		}
+		return v.is_arr() && t.i < v.as_arr().size() ? &v.as_arr()[t.i] : nullptr;
+	}
+	static void add(js_val& doc, const js_path& p, js_val&& u, size_t n) {
+		if (p.steps.empty()) {
+			doc = std::move(u);
+			return;
+		}
+		auto& v{ parent(doc, p, n) };
+		const auto& t{ p.steps.back() };
+		if (v.is_obj()) {
+			auto& m{ v.as_obj() };
+			if (const auto i{ m.find(std::string_view{ t.key }) }; i != m.end())
+				i->second = std::move(u);
+			else
+				m.try_emplace(js_str{ t.key }, std::move(u));
+		} else if (v.is_arr() && t.key == "-")
+			v.as_arr().push_back(std::move(u));
+		else if (v.is_arr() && t.i <= v.as_arr().size())
+			v.as_arr().insert(v.as_arr().begin() + ptrdiff_t(t.i), std::move(u));
+		else
+			bad("path NOT found", n);
+	}
+	// (N.B. - returns the REMOVED value)
+	static js_val remove(js_val& doc, const js_path& p, size_t n) {
+		if (p.steps.empty())
+			bad("can't remove the WHOLE document", n);
+		auto& v{ parent(doc, p, n) };
+		const auto& t{ p.steps.back() };
+		if (v.is_obj()) {
+			auto& m{ v.as_obj() };
+			if (const auto i{ m.find(std::string_view{ t.key }) }; i != m.end()) {
+				auto r{ std::move(i->second) };
+				m.erase(i);
+				return r;
+			}
+		} else if (v.is_arr() && t.i < v.as_arr().size()) {
+			auto& a{ v.as_arr() };
+			auto r{ std::move(a[t.i]) };
+			a.erase(a.begin() + ptrdiff_t(t.i));
+			return r;
+		}
+		bad("path NOT found", n);
+	}
+
+public:
+	// compute a patch (i.e., an array of operations) changing from to to... using
+	// "replace" for a value changed, and "add" and "remove" for object members
+	// and array elements added or removed (N.B. - NO "move" or "copy" is used)
+	static js_val diff(const js_val& from, const js_val& to) {
+		js_val ops{ js_arr{} };
+		std::string path;
+		diff(from, to, path, ops);
+		return ops;
+	}
+
+	// apply patch to doc, throwing a std::runtime_error (giving the [0-based]
+	// index of the operation) if ANY operation is malformed, its path (or from)
+	// is NOT a JSON Pointer (N.B. - js_path expressions are NOT accepted) or is
+	// NOT found, or a "test" fails... see above
+	static void apply(js_val& doc, const js_val& patch) {
+		if (!patch.is_arr())
+			bad("expected an ARRAY of operations", 0);
+		size_t n{};
+		for (const auto& o : patch.as_arr()) {
+			if (!o.is_obj())
+				bad("expected an OBJECT", n);
+			const auto& m{ o.as_obj() };
+			auto field = [&](std::string_view k, bool string) -> const js_val& {
+				const auto i{ m.find(k) };
+				if (i == m.end() || (string && !i->second.is_string()))
+					bad(string ? "expected a STRING member" : "expected a \"value\" member", n);
+				return i->second;
+			};
+			const std::string_view what{ field("op", true).as_string() };
+			const auto p{ pointer(field("path", true).as_string(), n) };
+			if (what == "add")
+				add(doc, p, js_val{ field("value", false) }, n);
+			else if (what == "remove")
+				remove(doc, p, n);
+			else if (what == "replace") {
+				if (const auto v{ find(doc, p, n) })
+					*v = field("value", false);
+				else
+					bad("path NOT found", n);
+			} else if (what == "move" || what == "copy") {
+				const auto& f{ field("from", true).as_string() };
+				const auto from{ pointer(f, n) };
+				if (what == "copy") {
+					if (const auto v{ find(doc, from, n) })
+						add(doc, p, js_val{ *v }, n);
+					else
+						bad("from NOT found", n);
+				} else if (const auto& t{ field("path", true).as_string() }; t.starts_with(f) && t.size() > f.size() && t[f.size()] == '/')
+					bad("can't move a value INTO itself", n);
+				else if (t != f)
+					add(doc, p, remove(doc, from, n), n);
+			} else if (what == "test") {
+				if (const auto v{ find(doc, p, n) }; !v || !(*v == field("value", false)))
+					bad("test failed", n);
+			} else
+				bad("unknown \"op\"", n);
+			++n;
+		}
+	}
+
+	// apply merge patch to doc, i.e., replace doc with patch - unless both are
+	// objects, when each member of patch is [recursively] merged into doc's, or
+	// [if null] removes doc's
+	static void merge(js_val& doc, const js_val& patch) {
+		if (!patch.is_obj()) {
+			doc = patch;
+			return;
+		}
+		if (!doc.is_obj())
+			doc = js_val{ js_obj{} };
+		auto& m{ doc.as_obj() };
+		for (const auto& [k, v] : patch.as_obj())
+			if (!v.is_null())
+				merge(m[k], v);
+			else if (const auto i{ m.find(std::string_view{ k }) }; i != m.end())
+				m.erase(i);
+	}
+};
+
+/*
+	key_table "interns" object keys, keeping ONE canonical copy of each distinct
+	key... js_compact_docs parsed using a key_table (see below) refer to these,
+	rather than each holding its own copies of its keys, which can save a LOT of
+	memory when [many] documents share the same keys - and allows their keys to
+	be compared just by address.
+
+	A key_table may be used by just one parser, or shared by any number of them
+	(in any number of threads, as it's thread-safe), and its keys are NEVER
+	removed... N.B. - it MUST outlive every js_compact_doc using it.
+*/
+class key_table {
+	struct hash {
+		using is_transparent = void;
+		size_t operator()(std::string_view s) const noexcept { return std::hash<std::string_view>{}(s); }
+	};
+	// (N.B. - an unordered_set NEVER moves its elements, so their addresses are stable)
+	std::unordered_set<std::string, hash, std::equal_to<>> keys;
+#ifndef NO_THREADS
+	mutable std::shared_mutex m;
+#endif
+
+public:
+	// return the canonical copy of s, adding it if NOT already present
+	const std::string& intern(std::string_view s) {
+		if (const auto k{ find(s) })
+			return *k;
+#ifndef NO_THREADS
+		std::unique_lock lock{ m };
+#endif
+		return *keys.emplace(s).first;
+	}
+	// ... or, WITHOUT adding it, nullptr if NOT present
+	const std::string* find(std::string_view s) const {
+#ifndef NO_THREADS
+		std::shared_lock lock{ m };
+#endif
+		const auto i{ keys.find(s) };
+		return i != keys.end() ? &*i : nullptr;
+	}
+	size_t size() const {
+#ifndef NO_THREADS
+		std::shared_lock lock{ m };
+#endif
+		return keys.size();
+	}
+};
+
+class js_compact;
+
+/*
+	js_compact_doc is a parsed JSON document in a COMPACT, read-only form, for when
+	[millions of] values are to be kept in memory... EVERY value is a 16-byte
+	"node" (vs the 56-byte js_val, plus the overhead of each std::map node, each
+	std::string, and any std::vector "slack"), any string of up to 14 bytes is held
+	IN its node, and longer strings - as well as the members and elements of ALL
+	objects and arrays - are held "out of line", in just two contiguous blocks of
+	memory for the whole document.
+
+	Values are accessed through js_compact "handles", whose is_*() and as_*()
+	methods mirror those of js_val (see js_compact).
+
+	Given a key_table, keys too long to be inline are instead interned in it, and
+	each such key node simply refers to its canonical copy (making lookups by key
+	into address comparisons, once the key sought has itself been found in the
+	key_table)... shorter keys are held IN their nodes, exactly as without one.
+
+	And parsed in_situ (see parse_opts), longer strings and keys with NO escapes
+	are NOT copied at all, each node instead referring to the JSON text itself.
+
+	As nodes refer to other nodes and to strings by offset, NOT by address, a
+	js_compact_doc may be saved as a "snapshot" - just a header, the nodes and
+	the strings - which load then memory-maps (see mapped_file) and, once its
+	nodes are checked, reads IN PLACE, so that NO parsing is needed to use it...
+	and ALL processes loading the same snapshot share the same [read-only] pages.
+*/
+class js_compact_doc {
+	friend class js_compact;
+
+	enum class kind : uint8_t {
+		null, false_, true_, number, integer, small_string, string, object, array,
+		key, // (interned, i.e., at is the address of a key_table's std::string)
+		view }; // (in situ, i.e., at is the address of the string in the JSON text)
+
+	// a node is its kind, then EITHER an "inline" string (its length, and up to
+	// 14 chars), OR a 32-bit size (of a string, object or array) at offset 4 and
+	// a 64-bit double, integer or offset (of chars, or of child nodes) at offset 8
+	// N.B. - an object of n members has 2n child nodes, alternating key and value
+	struct node {
+		kind k;
+		uint8_t n{};
+		char s[14]{};
+
+		template<class T>
+		T word() const noexcept {
+			T v;
+			std::memcpy(&v, s + (sizeof(T) == 8 ? 6 : 2), sizeof v);
+			return v;
+		}
+		template<class T>
+		void word(T v) noexcept { std::memcpy(s + (sizeof(T) == 8 ? 6 : 2), &v, sizeof v); }
+		size_t size() const noexcept { return word<uint32_t>(); }
+		size_t at() const noexcept { return size_t(word<uint64_t>()); }
+		static node ref(kind k, size_t size, size_t at) {
+			if (size > UINT32_MAX)
+				throw std::length_error("js_compact_doc: string, object or array too large");
+			node r{ k };
+			r.word(uint32_t(size)), r.word(uint64_t(at));
+			return r;
+		}
+	};
+	static_assert(sizeof(node) == 16);
+
+	std::vector<node> nodes; // (children of each object or array, then the root)
+	std::string chars; // (ALL strings too long to be inline, back to back)
+	key_table* keys{};
+	// (a loaded snapshot, if any, and where IN it the nodes and chars are)
+	std::shared_ptr<const mapped_file> file;
+	std::span<const node> file_nodes;
+	std::string_view file_chars;
+
+	// a snapshot is this header, then the nodes, then the chars
+	// N.B. - the "order" tells whether it was saved with the SAME byte order
+	struct header {
+		char magic[8]{ 'R', 'M', 'j', 's', 'n', 'a', 'p' };
+		uint32_t version{ 1 };
+		uint32_t order{ 0x01020304 };
+		uint64_t nodes, chars;
+	};
+
+	// (the nodes and chars... EITHER our own, OR those of a loaded snapshot)
+	const node* base() const noexcept { return file ? file_nodes.data() : nodes.data(); }
+	size_t count() const noexcept { return file ? file_nodes.size() : nodes.size(); }
+	std::string_view text() const noexcept { return file ? file_chars : std::string_view{ chars }; }
+
+	node string(std::string_view s) {
+		if (s.size() <= sizeof node::s) {
+			node r{ kind::small_string, uint8_t(s.size()) };
+			// (N.B. - an EMPTY view's data() may be nullptr, which memcpy mustn't get)
+			if (!s.empty())
+				std::memcpy(r.s, s.data(), s.size());
+			return r;
+		}
+		const auto at{ chars.size() };
+		chars.append(s);
+		return node::ref(kind::string, s.size(), at);
+	}
+
+	// the [SAX-style] handler that builds the nodes... the children of each open
+	// object or array are "pending" until it ends, when they're moved as a block
+	struct builder {
+		js_compact_doc& d;
+		std::vector<node> pending;
+		std::vector<size_t> open; // (index in pending of each one's FIRST child)
+		std::string_view src; // (the JSON text, if parsing in situ)
+
+		// (N.B. - a string with NO escapes is passed as a view of the JSON text)
+		node string(std::string_view s) {
+			const auto p{ uintptr_t(s.data()) }, b{ uintptr_t(src.data()) };
+			if (s.size() > sizeof node::s && p >= b && p + s.size() <= b + src.size())
+				return node::ref(kind::view, s.size(), p);
+			return d.string(s);
+		}
+
+		void start(kind k) {
+			pending.push_back(node{ k });
+			open.push_back(pending.size());
+		}
+		void end() {
+			const auto b{ open.back() };
+			const auto n{ pending.size() - b };
+			auto& c{ pending[b - 1] };
+			c = node::ref(c.k, c.k == kind::object ? n / 2 : n, d.nodes.size());
+			d.nodes.insert(d.nodes.end(), pending.begin() + ptrdiff_t(b), pending.end());
+			pending.resize(b);
+			open.pop_back();
+		}
+		void start_object() { start(kind::object); }
+		void key(std::string_view s) {
+			// (N.B. - a key short enough to be inline is NEVER interned, as its node
+			// is 16 bytes either way... so interning it would only cost memory)
+			if (!d.keys || s.size() <= sizeof node::s)
+				pending.push_back(string(s));
+			else {
+				const auto& k{ d.keys->intern(s) };
+				pending.push_back(node::ref(kind::key, k.size(), size_t(&k)));
+			}
+		}
+		void end_object() { end(); }
+		void start_array() { start(kind::array); }
+		void end_array() { end(); }
+		void value(nullptr_t) { pending.push_back(node{ kind::null }); }
+		void value(bool v) { pending.push_back(node{ v ? kind::true_ : kind::false_ }); }
+		void value(double v) {
+			node r{ kind::number };
+			r.word(v);
+			pending.push_back(r);
+		}
+		void value(js_int v) {
+			node r{ kind::integer };
+			r.word(v);
+			pending.push_back(r);
+		}
+		void value(std::string_view s) { pending.push_back(string(s)); }
+	};
+
+public:
+	// parse src, just as js_val::parse does (with the same options), but building
+	// a js_compact_doc - after which src is NOT needed (unless parsed in_situ)
+	explicit js_compact_doc(std::string_view src, const parse_opts& opts = {}) {
+		build(src, opts);
+	}
+	// ... interning ALL keys longer than 14 bytes in keys (see key_table)
+	js_compact_doc(std::string_view src, key_table& keys, const parse_opts& opts = {}) : keys(&keys) {
+		build(src, opts);
+	}
+	// the "root" value of the document
+	js_compact root() const noexcept;
+
+	// total bytes of memory used by the document (N.B. - NOT counting any key_table)
+	// ... or, for a loaded snapshot, mapped by it
+	size_t bytes() const noexcept {
+		return sizeof *this + nodes.capacity() * sizeof(node) + chars.capacity() + (file ? file->size() : 0);
+	}
+
+	/*
+		Write a snapshot of the document to the supplied output "sink" (e.g., a
+		std::string, to then be written to a file)... interned and in situ strings
+		are copied INTO the snapshot, so that it depends on nothing else at all.
+	*/
+	template<detail::char_sink Sink>
+	void save(Sink& o) const {
+		const auto b{ base() };
+		const auto n{ count() };
+		const auto c{ text().size() };
+		auto external = [](const node& e) { return e.k == kind::key || e.k == kind::view; };
+		size_t more{};
+		for (size_t i{}; i < n; ++i)
+			if (external(b[i]))
+				more += b[i].size();
+		const header h{ .nodes = n, .chars = c + more };
+		o.append(reinterpret_cast<const char*>(&h), sizeof h);
+		// (... rewriting interned and in situ strings as ordinary ones, following
+		// [in the same order] the strings of the document itself)
+		more = c;
+		for (size_t i{}; i < n; ++i)
+			if (!external(b[i]))
+				o.append(reinterpret_cast<const char*>(b + i), sizeof(node));
+			else {
+				const auto r{ node::ref(kind::string, b[i].size(), more) };
+				o.append(reinterpret_cast<const char*>(&r), sizeof r);
+				more += b[i].size();
+			}
+		o.append(text().data(), c);
+		for (size_t i{}; i < n; ++i)
+			if (b[i].k == kind::key)
+				o.append(reinterpret_cast<const std::string*>(b[i].at())->data(), b[i].size());
+			else if (b[i].k == kind::view)
+				o.append(reinterpret_cast<const char*>(b[i].at()), b[i].size());
+	}
+
+	/*
+		Load a snapshot (see save) from the file at path, by memory-mapping it...
+		throwing a std::system_error if it can't be opened or mapped (as for
+		mapped_file), or a std::runtime_error if it isn't a [whole] snapshot, was
+		saved with a different byte order, or is truncated or corrupted.
+
+		N.B. - to be safe with ANY file, every node IS checked (in a single pass,
+		which is still FAR cheaper than parsing): its kind, that its strings and
+		children lie within the snapshot, and that its children precede it (so
+		no value can contain itself)... after which the mapping is advised that
+		access will be random, as it is when navigating the document.
+
+		Only if trusted (e.g., a snapshot this process, or one it trusts, just
+		saved) is this pass skipped - so that NO node pages are touched until
+		they're used - and then ONLY the header and sizes are checked... loading
+		a corrupted snapshot as trusted is undefined behaviour.
+	*/
+	static js_compact_doc load(const std::filesystem::path& path, bool trusted = false) {
+		js_compact_doc d;
+		d.file = std::make_shared<const mapped_file>(path);
+		const auto z{ d.file->size() };
+		auto fail = [&](const char* what) {
+			throw std::runtime_error("Bad snapshot ("s + what + ") " + path.string());
+		};
+		if (z < sizeof(header))
+			fail("too small");
+		const auto p{ d.file->view().data() };
+		header h;
+		std::memcpy(&h, p, sizeof h);
+		if (const header x{}; std::memcmp(h.magic, x.magic, sizeof x.magic) || h.version != x.version)
+			fail("NOT a snapshot");
+		else if (h.order != x.order)
+			fail("different byte order");
+		const auto n{ (z - sizeof h) / sizeof(node) };
+		if (!h.nodes || h.nodes > n || h.chars != z - sizeof h - h.nodes * sizeof(node))
+			fail("wrong size");
+		// (N.B. - a node is just bytes, so needs NO particular alignment)
+		d.file_nodes = { reinterpret_cast<const node*>(p + sizeof h), size_t(h.nodes) };
+		d.file_chars = { p + sizeof h + h.nodes * sizeof(node), size_t(h.chars) };
+		// (is [at, at + m) within [0, limit)?)
+		auto within = [](size_t at, size_t m, size_t limit) { return at <= limit && m <= limit - at; };
+		const auto& b{ d.file_nodes };
+		if (!trusted)
+			for (size_t i{}; i < b.size(); ++i)
+				switch (const auto& e{ b[i] }; e.k) {
+				case kind::null: case kind::false_: case kind::true_: case kind::number: case kind::integer:
+					break;
+				case kind::small_string:
+					if (e.n > sizeof e.s)
+						fail("bad node");
+					break;
+				case kind::string:
+					if (!within(e.at(), e.size(), size_t(h.chars)))
+						fail("bad node");
+					break;
+				case kind::object:
+					if (!within(e.at(), 2 * e.size(), i))
+						fail("bad node");
+					for (size_t j{}; j < e.size(); ++j)
+						if (const auto k{ b[e.at() + 2 * j].k }; k != kind::small_string && k != kind::string)
+							fail("bad node");
+					break;
+				case kind::array:
+					if (!within(e.at(), e.size(), i))
+						fail("bad node");
+					break;
+				default: // (N.B. - save writes NO key or view nodes)
+					fail("bad node");
+				}
+		d.file->advise_random();
+		return d;
+	}
+
+private:
+	js_compact_doc() = default;
+
+	void build(std::string_view src, const parse_opts& opts) {
+		builder b{ *this, {}, {}, opts.in_situ ? src : std::string_view{} };
+		js_val::parse(src, b, opts);
+		nodes.push_back(b.pending.front());
+		nodes.shrink_to_fit();
+		chars.shrink_to_fit();
+	}
+};
+
+/*
+	js_compact is a [lightweight, freely copyable] reference to a value in a
+	js_compact_doc, with accessors like those of js_val... EXCEPT that strings are
+	returned as std::string_views (of the doc's own memory), and numbers by value.
+
+	As with js_val, asking for the wrong type throws std::bad_variant_access...
+	while a key or index NOT present in an object or array (respectively) throws
+	std::out_of_range.  And get() "materializes" the value as an actual js_val.
+*/
+class js_compact {
+	friend class js_compact_doc;
+	using kind = js_compact_doc::kind;
+	using node = js_compact_doc::node;
+
+	const js_compact_doc* d;
+	const node* p;
+
+	constexpr js_compact(const js_compact_doc* d, const node* p) noexcept : d(d), p(p) {}
+	constexpr void expect(bool ok) const {
+		if (!ok)
+			throw std::bad_variant_access();
+	}
+	const node* children() const noexcept { return d->base() + p->at(); }
+	// (key node of member with key s, or nullptr if NOT present... FIRST key wins)
+	const node* find(std::string_view s) const {
+		expect(is_obj());
+		const auto c{ children() };
+		if (d->keys && s.size() > sizeof node::s) {
+			// (interned keys are the SAME key only if at the same address)
+			if (const auto k{ d->keys->find(s) })
+				for (size_t i{}; i < p->size(); ++i)
+					if (c[2 * i].at() == size_t(k))
+						return c + 2 * i;
+			return nullptr;
+		}
+		for (size_t i{}; i < p->size(); ++i)
+			if (js_compact{ d, c + 2 * i }.as_string() == s)
+				return c + 2 * i;
+		return nullptr;
+	}
+
+public:
+	// query the type of the referenced value
+	constexpr bool is_null() const noexcept { return p->k == kind::null; }
+	constexpr bool is_bool() const noexcept { return p->k == kind::false_ || p->k == kind::true_; }
+	constexpr bool is_num() const noexcept { return p->k == kind::number || p->k == kind::integer; }
+	constexpr bool is_int() const noexcept { return p->k == kind::integer; }
+	constexpr bool is_string() const noexcept { return p->k == kind::small_string || p->k == kind::string || p->k == kind::key || p->k == kind::view; }
+	constexpr bool is_obj() const noexcept { return p->k == kind::object; }
+	constexpr bool is_arr() const noexcept { return p->k == kind::array; }
+
+	// return the referenced value
+	constexpr nullptr_t as_null() const { return expect(is_null()), nullptr; }
+	constexpr bool as_bool() const { return expect(is_bool()), p->k == kind::true_; }
+	double as_num() const {
+		expect(is_num());
+		return is_int() ? double(p->word<js_int>()) : p->word<double>();
+	}
+	js_int as_int() const { return expect(is_int()), p->word<js_int>(); }
+	std::string_view as_string() const {
+		expect(is_string());
+		if (p->k == kind::small_string)
+			return { p->s, p->n };
+		if (p->k == kind::key)
+			return *reinterpret_cast<const std::string*>(p->at());
+		if (p->k == kind::view)
+			return { reinterpret_cast<const char*>(p->at()), p->size() };
+		return { d->text().data() + p->at(), p->size() };
+	}
+
+	// number of members (or elements) of a referenced object (or array)
+	size_t size() const {
+		expect(is_obj() || is_arr());
+		return p->size();
+	}
+	bool contains(std::string_view s) const { return find(s) != nullptr; }
+
+	// "step into" the referenced object or array
+	js_compact operator[](std::string_view s) const {
+		if (const auto k{ find(s) })
+			return { d, k + 1 };
+		throw std::out_of_range("js_compact: key not found");
+	}
+	js_compact operator[](std::integral auto n) const {
+		expect(is_arr());
+		if (n < 0 || size_t(n) >= p->size())
+			throw std::out_of_range("js_compact: index out of range");
+		return { d, children() + n };
+	}
+
+	// "materialize" the ENTIRE referenced value (and all it contains) as a js_val
+	js_val get() const {
+		switch (p->k) {
+		case kind::null:
+			return nullptr;
+		case kind::false_:
+		case kind::true_:
+			return as_bool();
+		case kind::number:
+			return as_num();
+		case kind::integer:
+			return as_int();
+		case kind::small_string:
+		case kind::string:
+		case kind::key:
+		case kind::view:
+			return as_string();
+		case kind::object: {
+			js_val v{ js_obj{} };
+			auto& m{ v.as_obj() };
+			const auto c{ children() };
+			for (size_t i{}; i < p->size(); ++i)
+				detail::add_member(m, js_str{ js_compact{ d, c + 2 * i }.as_string() }, js_compact{ d, c + 2 * i + 1 }.get());
+			detail::end_members(m);
+			return v;
+		}
+		default: {
+			js_val v{ js_arr{} };
+			auto& a{ v.as_arr() };
+			a.reserve(size());
+			for (size_t i{}; i < p->size(); ++i)
+				a.push_back(js_compact{ d, children() + i }.get());
+			return v;
+		}
+		}
+	}
+};
+
+inline js_compact js_compact_doc::root() const noexcept { return { this, base() + count() - 1 }; }
+
+/*
+	js_builder is a [SAX-style] event handler that builds a js_val tree from the
+	events it is sent... exactly the tree js_val::parse would have built from the
+	same JSON text (e.g., the FIRST of any duplicate keys in an object "wins").
+
+	While it may be used with the streaming parse, it is chiefly intended to be
+	the handler for a push_parser, when a js_val is wanted from chunked input.
+*/
+class js_builder {
+	js_val root;
+	std::vector<js_val*> open; // (containers still being filled, innermost last)
+	js_str k;
+	size_t skip{}; // (nesting depth within an IGNORED [duplicate key] container)
+#ifdef USE_PMR
+	js_alloc<char> alloc;
+#else
+	static constexpr js_alloc<char> alloc{};
+#endif
+
+	// add a new value to the innermost open container (or make it THE value)
+	js_val* add(js_val&& v) {
+		if (open.empty())
+			return &(root = std::move(v));
+		if (auto& c{ *open.back() }; c.is_arr())
+			return &c.as_arr().emplace_back(std::move(v));
+		else
+			return detail::add_member(c.as_obj(), std::move(k), std::move(v));
+	}
+	void start(js_val&& v) {
+		if (skip)
+			++skip;
+		else if (const auto p{ add(std::move(v)) }; p)
+			open.push_back(p);
+		else
+			skip = 1;
+	}
+
+public:
+#ifdef USE_PMR
+	// (mr supplies ALL storage for the built tree, nullptr = default resource)
+	explicit js_builder(std::pmr::memory_resource* mr = nullptr) :
+		k(mr ? mr : std::pmr::get_default_resource()), alloc(k.get_allocator()) {}
+#else
+	js_builder() = default;
+#endif
+
+	void start_object() { start(js_obj(alloc)); }
+	void key(std::string_view s) {
+		if (!skip)
+			k.assign(s);
+	}
+	void end_object() {
+		if (skip)
+			--skip;
+		else
+			detail::end_members(open.back()->as_obj()), open.pop_back();
+	}
+	void start_array() { start(js_arr(alloc)); }
+	void end_array() {
+		if (skip)
+			--skip;
+		else
+			open.pop_back();
+	}
+	void value(nullptr_t) {
+		if (!skip)
+			add(js_val{ nullptr });
+	}
+	void value(bool v) {
+		if (!skip)
+			add(js_val{ v });
+	}
+	void value(double v) {
+		if (!skip)
+			add(js_val{ v });
+	}
+	void value(js_int v) {
+		if (!skip)
+			add(js_val{ v });
+	}
+	void value(std::string_view s) {
+		if (!skip)
+			add(js_val{ js_str(s, alloc) });
+	}
+
+	// the value built so far (COMPLETE once the parser has finished)
+	inline const js_val& get() const noexcept { return root; }
+	inline js_val& get() noexcept { return root; }
+	// (... or MOVE it out, leaving this builder ready to build again)
+	inline js_val take() {
+		open.clear(), skip = 0;
+		return std::move(root);
+	}
+};
+
+/*
+	push_parser is an "incremental" JSON parser, which is fed its input in as many
+	chunks (of any size) as are convenient - straight from socket reads or pipe
+	buffers, say - rather than needing ALL of the JSON text as one string_view.
+
+	Like the streaming js_val::parse, it calls the event methods of a handler as
+	it recognizes parts of the JSON text (use a js_builder to get a js_val), and
+	performs exactly the same checking, with exceptions giving the offending
+	offset in the WHOLE text (i.e., counting the bytes of all chunks fed so far).
+
+	Its state is kept between calls to feed() - including a token (a string, say)
+	split across chunks, in which case ONLY that token is buffered... so memory
+	used is bounded by the nesting depth and the longest token, NOT the document.
+	Call finish() once the input has ended, to complete (and check) the parse.
+
+	N.B. - unlike js_val::parse, ONLY whitespace may follow the [single] value.
+*/
+template<detail::sax_events Handler>
+class push_parser {
+	using lexer = js_val::lexer;
+	using parse_state = js_val::parse_state;
+
+	// what is expected next... (first_key and first_value also allow '}' / ']')
+	enum class expect : uint8_t { value, first_value, key, first_key, colon, more, done };
+	// the kind of token [if any] split across chunks, held in carry
+	enum class partial : uint8_t { none, string, number, keyword };
+
+	Handler& h;
+	expect want{ expect::value };
+	std::vector<char> nest; // ('{' or '[' for each open container)
+	unsigned max_depth; // (see parse_opts)
+	size_t at{}; // (offset of current chunk in the whole text)
+	partial tok{ partial::none };
+	std::string carry;
+	size_t carry_at{};
+	bool esc{}; // (last char of a partial string was an escaping '\\')
+	uint8_t bom{}; // (count of utf-8 BOM bytes seen, or 3 once past any BOM)
+	std::string scratch;
+
+	static constexpr auto is_ws(char c) noexcept { return lexer::is_ws(c); }
+	static constexpr auto is_num(char c) noexcept {
+		return detail::isdigit(c) || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E';
+	}
+
+	// throw the appropriate exception for an unexpected token at offset o
+	[[noreturn]] void unexpected(size_t o) const {
+		using namespace std::string_literals;
+		const auto what =
+			want == expect::value || want == expect::first_value ? "expected VALUE" :
+			want == expect::key || want == expect::first_key ? "OBJECT: expected STRING" :
+			want == expect::colon ? "OBJECT: expected ':'" :
+			want == expect::done ? "unexpected text after VALUE" :
+			nest.back() == '{' ? "OBJECT: expected ',' or '}'" :
+			"ARRAY: expected ',' or ']'";
+		throw std::runtime_error("Bad parse ("s + what + ") @ " + std::to_string(o));
+	}
+	constexpr void end_value() noexcept { want = nest.empty() ? expect::done : expect::more; }
+
+	// return offset of closing '"' of string in s (scanning from i), or npos
+	size_t string_end(std::string_view s, size_t i) noexcept {
+		const auto e{ s.data() + s.size() };
+		while (i < s.size()) {
+			if (esc)
+				esc = false, ++i;
+			else if (const auto p{ detail::find_string_special<false>(s.data() + i, e) }; p == e)
+				break;
+			else if (i = p - s.data(); *p == '"')
+				return i;
+			else
+				esc = *p == '\\', ++i;
+		}
+		return std::string_view::npos;
+	}
+
+	// handle a COMPLETE value token t, found at offset o in the whole text
+	void token(partial k, std::string_view t, size_t o) {
+		lexer lx{ t, o };
+		if (k == partial::string && (want == expect::key || want == expect::first_key)) {
+			detail::view_sink v{ scratch };
+			lx.string(v);
+			h.key(v.view());
+			want = expect::colon;
+			return;
+		}
+		if (want != expect::value && want != expect::first_value)
+			unexpected(o);
+		if (k == partial::string) {
+			detail::view_sink v{ scratch };
+			lx.string(v);
+			h.value(v.view());
+		} else if (k == partial::number) {
+			lx.number([&](auto n) { detail::number_event(h, n); });
+			// (N.B. - the WHOLE token must be the number, NOT just a valid prefix)
+			if (lx.co != t.size())
+				throw std::runtime_error("Bad parse (NUMBER) @ "s + std::to_string(o));
+		} else if (const auto v{ lx.keyword() }; v.is_null())
+			h.value(nullptr);
+		else
+			h.value(v.as_bool());
+		end_value();
+	}
+
+	// continue a token split across chunks, returning false if STILL incomplete
+	bool resume(std::string_view s, size_t& i) {
+		size_t e;
+		if (tok == partial::string) {
+			if (e = string_end(s, 0); e == std::string_view::npos)
+				return carry.append(s), false;
+			++e;
+		} else
+			for (e = 0; e < s.size() && (tok == partial::number ? is_num(s[e]) : detail::isalpha(s[e])); ++e) ;
+		carry.append(s.substr(0, e));
+		if (e == s.size() && tok != partial::string)
+			return false;
+		i = e;
+		const auto k{ tok };
+		tok = partial::none;
+		token(k, carry, carry_at);
+		return true;
+	}
+
+public:
+	// (N.B. - ONLY the max_depth option applies to a push_parser)
+	explicit push_parser(Handler& h, const parse_opts& opts = {}) noexcept : h(h), max_depth(opts.max_depth) {}
+
+	// parse the next chunk of JSON text
+	void feed(std::string_view s) {
+		size_t i{};
+		if (tok != partial::none && !resume(s, i)) {
+			at += s.size();
+			return;
+		}
+		while (i < s.size()) {
+			const auto c{ s[i] };
+			// Detect and IGNORE utf-8 BOM at beginning of JSON text... (not reversible)
+			if (bom < 3) {
+				if ((char8_t)c == (char8_t)"\xEF\xBB\xBF"[bom]) {
+					++bom, ++i;
+					continue;
+				} else if (bom)
+					unexpected(at + i - bom); // (NOT a [complete] BOM after all)
+				bom = 3;
+			}
+			if (is_ws(c)) {
+				++i;
+				continue;
+			}
+			switch (c) {
+			case '"':
+				if (const auto e{ string_end(s, i + 1) }; e != std::string_view::npos) {
+					token(partial::string, s.substr(i, e + 1 - i), at + i);
+					i = e + 1;
+				} else {
+					tok = partial::string, carry.assign(s.substr(i)), carry_at = at + i;
+					i = s.size();
+				}
+				break;
+			case '-':
+			case '0': case '1': case '2': case '3': case '4':
+			case '5': case '6': case '7': case '8': case '9':
+			case 'f': case 'n': case 't': {
+				const auto k{ c == 'f' || c == 'n' || c == 't' ? partial::keyword : partial::number };
+				auto e{ i };
+				while (++e < s.size() && (k == partial::number ? is_num(s[e]) : detail::isalpha(s[e]))) ;
+				if (e < s.size())
+					token(k, s.substr(i, e - i), at + i);
+				else
+					tok = k, carry.assign(s.substr(i)), carry_at = at + i;
+				i = e;
+				break;
+			}
+			case '{':
+			case '[':
+				if (want != expect::value && want != expect::first_value)
+					unexpected(at + i);
+				if (max_depth && nest.size() >= max_depth)
+					throw std::runtime_error("Bad parse (maximum depth exceeded) @ "s + std::to_string(at + i));
+				c == '{' ? h.start_object() : h.start_array();
+				nest.push_back(c);
+				want = c == '{' ? expect::first_key : expect::first_value;
+				++i;
+				break;
+			case '}':
+			case ']':
+				if (const auto o{ c == '}' ? '{' : '[' }; nest.empty() || nest.back() != o ||
+					(want != expect::more && want != (o == '{' ? expect::first_key : expect::first_value)))
+					unexpected(at + i);
+				c == '}' ? h.end_object() : h.end_array();
+				nest.pop_back();
+				end_value();
+				++i;
+				break;
+			case ':':
+				if (want != expect::colon)
+					unexpected(at + i);
+				want = expect::value;
+				++i;
+				break;
+			case ',':
+				if (want != expect::more)
+					unexpected(at + i);
+				want = nest.back() == '{' ? expect::key : expect::value;
+				++i;
+				break;
+			default:
+				unexpected(at + i);
+			}
+		}
+		at += s.size();
+	}
+
+	// signal the END of the JSON text, completing any token still in progress
+	void finish() {
+		if (const auto k{ tok }; k != partial::none)
+			tok = partial::none, token(k, carry, carry_at);
+		if (want != expect::done)
+			unexpected(at);
+	}
+
+	// (has a complete JSON value been parsed?)
+	constexpr bool done() const noexcept { return want == expect::done && tok == partial::none; }
+};
+
+// "user-defined suffix" making a "bare" INTEGER a js_num (i.e., a double) in
+// js_val exprs... N.B. - since integral values become js_ints, the two differ:
+// e.g., js_arr a{0, 1, 2} holds js_ints, while js_arr a{0_js, 1_js, 2_js} - as
+// does js_arr a{0.0, 1.0, 2.0} - holds doubles (though both compare EQUAL, as
+// numbers compare by value, whichever alternative holds them)
+constexpr auto operator""_js(unsigned long long v) noexcept { return (js_num)v; }
 
 #ifndef NO_STREAM
 const auto pass_thru = 42; // (used to enable "pass_thru" in js_val operator<<)
@@ -765,16 +4349,53 @@ const auto pass_thru = 42; // (used to enable "pass_thru" in js_val operator<<)
 // example:
 // os << std::setw(rmj::pass_thru) << rmj::parse("a\u0807\u0808c") << std::endl;
 inline std::ostream& operator<<(std::ostream& os, const js_val& v) {
+	// (buffered sink adapter for output streams, to avoid "per-char" overhead)
+	struct ostream_sink {
+		std::ostream& os;
+		size_t n{};
+		char b[4096];
+		// (N.B. - b is left UNinitialized, as only b[0..n) is ever written out)
+		explicit ostream_sink(std::ostream& os) noexcept : os(os) {}
+		void append(const char* p, size_t m) {
+			if (n + m > std::size(b))
+				flush();
+			if (m >= std::size(b))
+				os.write(p, std::streamsize(m));
+			else
+				std::copy(p, p + m, b + n), n += m;
+		}
+		void push_back(char c) {
+			if (n == std::size(b))
+				flush();
+			b[n++] = c;
+		}
+		void flush() { os.write(b, std::streamsize(n)), n = 0; }
+	};
 	const auto w{ os.width() };
-	// (if using "pass_thru" mode, field width control is really a non-issue)
-	if (w == pass_thru)
-		os.width(0);
-	return os << v.to_string(w == pass_thru);
+	// (a "real" field width requires knowing the output length up front...)
+	if (w != 0 && w != pass_thru)
+		return os << v.to_string();
+	// (... while if using "pass_thru" mode, field width control is a non-issue)
+	os.width(0);
+	ostream_sink o{ os };
+	v.stringify(o, w == pass_thru);
+	o.flush();
+	return os;
 }
 #endif
 
 }
 
+// (so that js_vals, and js_hasheds, may be keys of unordered containers)
+template<>
+struct std::hash<rmj::js_val> {
+	size_t operator()(const rmj::js_val& v) const noexcept { return v.hash(); }
+};
+template<>
+struct std::hash<rmj::js_hashed> {
+	size_t operator()(const rmj::js_hashed& v) const noexcept { return v.hash(); }
+};
+
 #ifndef NO_FORMAT
 // custom c++20 "formatter" for use with rmj::js_val values
 // N.B. - use '_' format specifier to invoke "pass_thru" operation of to_string!
@@ -783,7 +4404,7 @@ inline std::ostream& operator<<(std::ostream& os, const js_val& v) {
 // os << std::format("{:_}\n", rmj::parse("a\u0807\u0808c"));
 namespace std {
 	template<>
-	struct formatter<rmj::js_val> : formatter<string_view> {
+	struct formatter<rmj::js_val> {
 		bool pass_thru{};
 		constexpr auto parse(format_parse_context& ctx) {
 			auto it{ ctx.begin() };
@@ -794,7 +4415,10 @@ namespace std {
 			return it;
 		}
 		auto format(const rmj::js_val& v, format_context& ctx) const {
-			return formatter<string_view>::format(v.to_string(pass_thru), ctx);
+			// (stringify DIRECTLY into the formatting output, NO interim std::string)
+			rmj::detail::iterator_sink o{ ctx.out() };
+			v.stringify(o, pass_thru);
+			return o.out;
 		}
 	};
 }
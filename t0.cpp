@@ -8,12 +8,53 @@
 #include <fstream>
 #include <filesystem>
 #include <chrono>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <optional>
+#include <unordered_set>
 #include "rmj.h"
 
 namespace fs = std::filesystem;
 namespace kr = std::chrono;
 using namespace rmj;
 
+// count ALL [global] heap allocations, so we can see what parsing "costs"
+static std::atomic<size_t> allocs{};
+
+void* operator new(size_t n)
+{
+	++allocs;
+	if (auto p = std::malloc(n ? n : 1))
+		return p;
+	throw std::bad_alloc();
+}
+// (N.B. - NOT inlined, so that GCC doesn't "see" operator new memory passed to
+// std::free, and warn of a mismatched allocation function)
+#ifdef __GNUC__
+[[gnu::noinline]]
+#endif
+static void release(void* p) noexcept { std::free(p); }
+void operator delete(void* p) noexcept { release(p); }
+void operator delete(void* p, size_t) noexcept { release(p); }
+// (std::pmr's default resource uses the "aligned" forms, so count those too)
+void* operator new(size_t n, std::align_val_t a)
+{
+	// over-allocate, then stash the "real" pointer just before the aligned one
+	const auto al = std::max(size_t(a), sizeof(void*));
+	const auto p = static_cast<char*>(operator new(n + al + sizeof(void*)));
+	const auto q = p + sizeof(void*) + (al - (uintptr_t(p + sizeof(void*)) % al)) % al;
+	reinterpret_cast<void**>(q)[-1] = p;
+	return q;
+}
+void operator delete(void* p, std::align_val_t) noexcept
+{
+	if (p)
+		release(reinterpret_cast<void**>(p)[-1]);
+}
+void operator delete(void* p, size_t, std::align_val_t a) noexcept { operator delete(p, a); }
+
 int main(int argc, char* argv[])
 {
 	//std::locale::global(std::locale("en_US.UTF-8"));
@@ -30,7 +71,7 @@ int main(int argc, char* argv[])
 		js_val z_3 = std::move(z_z);
 		// N.B. - post "move", z_z's VALUE is undefined - including z_z.empty()!
 		std::cout << "z_3=" << z_3 << " (results of z_3 = std::move(z_z))" << std::endl;
-		// N.B. - C++ initializer list values that are *numeric* MUST be doubles
+		// N.B. - C++ initializer list INTEGERS are js_ints, so use _js for doubles
 		js_val x{ js_arr{true, false, js_arr{0_js, 1_js}} };
 		// N.B. - this is C++, NOT JavaScript, so "objects" look like pairs when
 		// appearing in initializer lists... in below examples, note lack of ':'
@@ -57,6 +98,103 @@ int main(int argc, char* argv[])
 			std::cout << "got js_obj" << std::endl;
 			std::cout << "got double=" << a["b"].as_num() << " (using default std::ostream output)" << std::endl;
 			std::cout << "got double=" << a["b"] << " (using rmj::operator<< output)" << std::endl;
+			// (N.B. - a CONST js_val's operator[] never adds a member, so throws if NOT present)
+			try {
+				const auto& ca{ a };
+				const auto& c{ ca["c"] };
+				std::cout << "const a[\"c\"] -> " << c << std::endl;
+			} catch (std::out_of_range& e) {
+				std::cout << "const a[\"c\"] -> exception, 'what()'=" << e.what() << " (size " << a.as_obj().size() << ")" << std::endl;
+			}
+		}
+		// (integers too large for a double to hold exactly are kept as integers)
+		{
+			const auto id{ js_val::parse("9007199254740993") };
+			std::cout << "parse(9007199254740993) -> " << id << " (is_int()=" << id.is_int()
+				<< ", == 9007199254740992.0 -> " << (id == 9007199254740992.0) << ")" << std::endl;
+		}
+		// (... or parse numbers "lazily", keeping their EXACT text until needed)
+		{
+			const auto text{ R"([1.50,1e2,123456789012345678901234567890])" };
+			const auto raw{ js_val::parse(text, { .lazy_numbers = true }) };
+			std::cout << "parse(" << text << ", { .lazy_numbers = true }) -> " << raw
+				<< " (raw[1].as_num()=" << raw[1].as_num() << ")" << std::endl;
+		}
+#ifdef USE_ORDERED_MAP
+		// (... which, with members kept in order, re-serializes "to_string form"
+		// text byte for byte - but normalizes anything else)
+		for (const auto text : { R"({"z":1.50,"a":[1e2,-0],"s":"x\ny\u0001\u00e9"})",
+			R"({"z": 1, "a":"\/é"})", R"({"a":1,"a":2})" }) {
+			const auto v{ js_val::parse(text, { .lazy_numbers = true }) };
+			std::cout << "round trip " << text << " -> " << v
+				<< (v.to_string() == text ? " (SAME bytes)" : " (normalized)") << std::endl;
+		}
+#endif
+		// (... or keep many compact documents, all sharing ONE copy of their keys)
+		{
+			key_table keys;
+			const js_compact_doc d1{ R"({"id":1,"name":"a","tags":[],"last_modified_time":0})", keys };
+			const js_compact_doc d2{ R"({"id":2,"name":"b","tags":[{"id":3}],"last_modified_time":5})", keys };
+			std::cout << "key_table size=" << keys.size() << " (ONLY keys longer than 14 bytes), d2[\"tags\"][0][\"id\"]="
+				<< d2.root()["tags"][0]["id"].as_int() << ", d2[\"last_modified_time\"]="
+				<< d2.root()["last_modified_time"].as_int() << ", d1=" << d1.root().get() << std::endl;
+		}
+		// (... or keep a value whose text is cached, so small edits re-serialize fast)
+		{
+			js_cached_doc doc{ js_val::parse(R"({"config":{"a":[1,2,3],"b":{"c":true}},"version":1})") };
+			std::cout << "js_cached_doc -> " << doc.to_string();
+			doc.edit(js_path{ "/version" }, [](js_val& v) { v = js_val{ 2 }; });
+			std::cout << ", edited -> " << doc.to_string() << std::endl;
+			// (... and NOTHING but edit can change it, so its text is never "stale")
+			static_assert(std::is_const_v<std::remove_reference_t<decltype(doc->as_obj())>>);
+			try {
+				(void)(*doc)["missing"];
+			} catch (std::out_of_range&) {
+				std::cout << "js_cached_doc const [\"missing\"] -> exception, unchanged "
+					<< (doc.to_string() == doc->to_string()) << std::endl;
+			}
+		}
+		// (... or "dedupe" values, using their [deep] hashes)
+		{
+			std::unordered_set<js_hashed> seen;
+			for (const auto text : { R"({"a":1,"b":[2]})", R"({"b":[2.0],"a":1})", R"({"a":1,"b":[3]})" })
+				seen.emplace(js_val::parse(text));
+			std::cout << "unordered_set<js_hashed> size=" << seen.size() << " (1 == 1.0 -> hash equal "
+				<< (std::hash<js_val>{}(1_js) == std::hash<js_val>{}(js_val{ 1.0 })) << ")" << std::endl;
+		}
+		// (... or send just the "delta" between values, as a JSON Patch or Merge Patch)
+		{
+			auto from{ js_val::parse(R"({"a":1,"b":[1,2,3],"c":{"d":"x"}})") };
+			const auto to{ js_val::parse(R"({"a":1,"b":[1,3],"c":{"d":"y","e/f":null}})") };
+			const auto ops{ js_patch::diff(from, to) };
+			std::cout << "js_patch::diff -> " << ops;
+			js_patch::apply(from, ops);
+			std::cout << ", applied " << (from == to);
+			js_patch::merge(from, js_val::parse(R"({"a":null,"c":{"d":"z"}})"));
+			std::cout << ", merged -> " << from << std::endl;
+			// (N.B. - a patch's paths MUST be JSON Pointers, NOT js_path expressions)
+			for (const auto text : { R"([{"op":"test","path":"/c/d","value":"z"},{"op":"remove","path":"$..d"}])",
+				R"([{"op":"copy","from":"/a~2","path":"/b"}])" })
+				try {
+					js_patch::apply(from, js_val::parse(text));
+				} catch (std::runtime_error& e) {
+					std::cout << "js_patch::apply(" << text << ") -> exception, 'what()'=" << e.what() << std::endl;
+				}
+		}
+		// (... or [round trip] values through the binary CBOR and MessagePack formats)
+		{
+			const auto v{ js_val::parse(R"({"id":12345,"pi":3.14159,"ok":true,"tags":["x","y"]})") };
+			const auto cbor{ v.to_binary(binary_format::cbor) }, mp{ v.to_binary(binary_format::msgpack) };
+			std::cout << "to_binary(cbor) -> " << cbor.size() << " bytes, (msgpack) -> " << mp.size()
+				<< " bytes (vs " << v.to_string().size() << " as text), round trips "
+				<< (js_val::parse_binary(cbor, binary_format::cbor) == v && js_val::parse_binary(mp, binary_format::msgpack) == v)
+				<< std::endl;
+			// (... but NOT anything JSON can't hold, e.g., a CBOR "half" float infinity)
+			try {
+				(void)js_val::parse_binary(std::string_view{ "\xf9\x7c\x00", 3 }, binary_format::cbor);
+			} catch (std::exception& e) {
+				std::cout << "parse_binary(f9 7c 00) -> exception, 'what()'=" << e.what() << std::endl;
+			}
 		}
 
 		// ... then check out our "spaceship" and [default] == operators...
@@ -115,6 +253,15 @@ int main(int argc, char* argv[])
 		std::cout << "y[\"0\"]=" << y["0"] << std::endl;
 		std::cout << "x[2][0]=" << x[2][0] << std::endl;
 		std::cout << "a[\"a\"][4][\"ab\"]=" << a["a"][4]["ab"] << std::endl;
+		// ... or [compile once, then] select values with a JSON Pointer or path
+		// expression, which NEVER inserts anything - nor allocates when run
+		{
+			const js_path ab{ "/a/4/ab" }, all{ "$.a[*]" };
+			std::cout << "js_path(/a/4/ab).get(a)=" << ab.get(std::as_const(a)) << std::endl;
+			std::cout << "js_path($.a[*]).for_each(a) ->";
+			all.for_each(std::as_const(a), [](const js_val& v) { std::cout << " " << v; });
+			std::cout << std::endl;
+		}
 		// N.B. - in *assignments* we allow ANY believable *numeric* value when a
 		// [JSON] number is desired, whereas C++ would NOT recognize an integer as a
 		// [JSON] number, but it WOULD allow either nullptrs or bools to act like
@@ -146,6 +293,11 @@ int main(int argc, char* argv[])
 		std::cout << "parse(\"[ 1.2, 3.4 ]\") -> "
 			<< js_val::parse("[ 1.2, 3.4 ]") << std::endl;
 
+		// ... or stringify into a caller-supplied [and re-usable] buffer...
+		std::string buf;
+		js_val::parse("{ \"abc\" : [ 1.2, 3.4 ] }").stringify(buf);
+		std::cout << "stringify({ \"abc\" : [ 1.2, 3.4 ] }) -> " << buf << std::endl;
+
 		// ... with "we're not in Kansas anymore" UTF-8...
 		std::cout << "parse(null) -> " << js_val::parse("null") << std::endl;
 		std::cout << "parse(false) -> " << js_val::parse("false") << std::endl;
@@ -165,6 +317,9 @@ int main(int argc, char* argv[])
 			<< js_val::parse("{ \"def\" : 42 }") << std::endl;
 		std::cout << "parse(\"{ \"def\" : 42, \"ghi\" : 77 }\") -> "
 			<< js_val::parse("{ \"def\" : 42, \"ghi\" : 77 }") << std::endl;
+		// (members are output in key order... unless USE_ORDERED_MAP is defined)
+		std::cout << "parse(\"{ \"ghi\" : 77, \"def\" : 42 }\") -> "
+			<< js_val::parse("{ \"ghi\" : 77, \"def\" : 42 }") << std::endl;
 		std::cout << "parse(\"27\") -> " << js_val::parse("27") << std::endl;
 		std::cout << "parse(\"27e0\") -> " << js_val::parse("27e0") << std::endl;
 		std::cout << "parse(\"27e-10\") -> " << js_val::parse("27e-10") << std::endl;
@@ -208,6 +363,63 @@ int main(int argc, char* argv[])
 				js_val::parse("\"我能吞下玻璃而不伤身体\""));
 #endif
 
+		// ... or "stream" through a doc (SAX-style) WITHOUT creating any js_vals...
+		{
+			struct counter : sax_handler {
+				using sax_handler::value;
+				size_t keys{}, nums{};
+				void key(std::string_view) { ++keys; }
+				void value(double) { ++nums; }
+			} c;
+			const auto doc{ R"({"a":[1,2,{"b":3}],"c":"d"})" };
+			js_val::parse(doc, c);
+			std::cout << "parse(" << doc << ", counter) -> "
+				<< c.keys << " keys, " << c.nums << " numbers" << std::endl;
+		}
+
+		// ... or parse JSON text arriving in [arbitrarily split] chunks...
+		{
+			js_builder b;
+			push_parser p{ b };
+			std::cout << "push_parser:";
+			for (const auto chunk : { R"({"a":[1,2)", R"(.5,"x\u00)", R"(41y"],"b":{"c":tr)", "ue}}" })
+				std::cout << " feed(" << chunk << ")", p.feed(chunk);
+			p.finish();
+			std::cout << " -> " << b.get() << std::endl;
+			// (a number token must be WHOLLY a number, however the text is split)
+			for (const auto bad : { "[1e5e5]", "[2.5e3-1]", "[1E+2+]", "[0.5e-3-]" })
+				for (size_t k = 1; k < std::strlen(bad); k += 3)
+					try {
+						js_builder b2;
+						push_parser p2{ b2 };
+						p2.feed(std::string_view{ bad }.substr(0, k)), p2.feed(bad + k), p2.finish();
+						std::cout << "push_parser(" << bad << ") -> " << b2.get() << " (NOT rejected!)" << std::endl;
+					} catch (std::exception& e) {
+						if (k == 1)
+							std::cout << "push_parser(" << bad << ") -> exception, 'what()'=" << e.what() << std::endl;
+					}
+		}
+
+		// ... or parse "newline-delimited" JSON (NDJSON), one js_val per line...
+		{
+			const auto ndjson{ "{\"a\":1}\n[2,3]\n\n\"four\"\n" };
+			std::cout << "parse_lines({\"a\":1}\\n[2,3]\\n\\n\"four\"\\n) ->";
+			for (const auto& v : js_val::parse_lines(ndjson))
+				std::cout << " " << v;
+			std::cout << std::endl;
+		}
+
+		// ... count the allocations needed to parse a [small] "key-heavy" doc...
+		// (expect one per object or array, plus one per string that is "long")
+		{
+			const auto keys{ R"([{"id":1,"name":"a","tags":["x","y"],"ok":true},)"
+				R"({"id":2,"name":"b","tags":[],"ok":false,"note":"a string > 16 chars"}])" };
+			const auto n0{ allocs.load() };
+			const auto v{ js_val::parse(keys) };
+			std::cout << "parse(" << keys << ") -> "
+				<< (allocs.load() - n0) << " allocations" << std::endl;
+		}
+
 		// ... finally, see if we can throw useful exceptions on parsing errors
 		try {
 			js_val::parse("27eNON-NUMBER");
@@ -227,28 +439,123 @@ int main(int argc, char* argv[])
 			std::cerr << "parse({\"a\":2,,}) -> "
 				<< "Exception: " << e.what() << std::endl;
 		}
+		try {
+			js_val::parse("[[[[1]]]]", { .max_depth = 3 });
+		} catch (std::exception& e) {
+			std::cerr << "parse([[[[1]]]], { .max_depth = 3 }) -> "
+				<< "Exception: " << e.what() << std::endl;
+		}
+		try {
+			js_val::parse_lines("[1]\n[2]\n[3,,]\n");
+		} catch (std::exception& e) {
+			std::cerr << "parse_lines([1]\\n[2]\\n[3,,]\\n) -> "
+				<< "Exception: " << e.what() << std::endl;
+		}
 	} else
 		// [presumed] JSON file supplied, attempt to read, parse, and print it
 		try {
-			std::string text;
 			const auto p = fs::path(argv[1]);
-			// first, read the entire file into a std::string...
-			if (std::ifstream f(p, std::ios::binary); f) {
-				const auto n = size_t(fs::file_size(p)); // (can't throw)
-				text.reserve(n), text.resize(n);
-				const auto nn = f.read(text.data(), n).gcount();
-				if (nn != n)
-					throw std::invalid_argument("Unable to read "s + argv[1]);
-			} else
-				throw std::invalid_argument("Unable to open "s + argv[1]);
 			std::cerr << "Parsing " << argv[1] << std::endl;
 			const auto t0 = kr::steady_clock::now();
-			// ... then, parse it (looking for legal JSON, and tracking time)...
-			auto json = js_val::parse(text);
+			const auto n0 = allocs.load();
+			// parse it (looking for legal JSON, and tracking time) directly from the
+			// [memory-mapped] file, so NO copy of the whole file is ever made...
+			auto json = js_val::parse_file(p);
 			const auto t1 = kr::steady_clock::now();
+			const auto n1 = allocs.load();
 			// ... then stringify the parsed js_val...
 			const auto text2 = json.to_string();
 			const auto t2 = kr::steady_clock::now();
+			// (... and map it again, to use its JSON text "as is" for the below)
+			const mapped_file file{ p };
+			const auto text{ file.view() };
+			// ... and parse it again, "streaming" (SAX-style) this time...
+			struct counter : sax_handler {
+				using sax_handler::value;
+				size_t n{};
+				void key(std::string_view) { ++n; }
+				void value(nullptr_t) { ++n; }
+				void value(bool) { ++n; }
+				void value(double) { ++n; }
+				void value(std::string_view) { ++n; }
+			} c;
+			const auto n2 = allocs.load();
+			js_val::parse(text, c);
+			const auto t2a = kr::steady_clock::now();
+			const auto n2a = allocs.load();
+			// ... and again, reading the file in chunks (using a push_parser), so
+			// that ALL of the JSON text need NOT be held in memory at once
+			js_builder b;
+			push_parser pp{ b };
+			if (std::ifstream f(p, std::ios::binary); f) {
+				static char buf[65536];
+				while (f.read(buf, sizeof buf) || f.gcount())
+					pp.feed({ buf, size_t(f.gcount()) });
+			}
+			pp.finish();
+			const auto t2b = kr::steady_clock::now();
+			// ... and lazily (to a "tape"), materializing NO js_vals at all
+			const js_lazy_doc lazy{ text };
+			const auto root{ lazy.root() };
+			const auto top{ root.is_obj() || root.is_arr() ? root.size() : 1 };
+			const auto t2c = kr::steady_clock::now();
+			// ... and into a js_compact_doc (16-byte nodes), checking it's the same
+			const js_compact_doc compact{ text };
+			const auto t2d = kr::steady_clock::now();
+			const auto compact_same{ compact.root().get() == json };
+			// (... and again "in situ", its unescaped strings being views of text)
+			const auto t2e = kr::steady_clock::now();
+			const js_compact_doc situ{ text, { .in_situ = true } };
+			const auto t2f = kr::steady_clock::now();
+			// (... then save it as a snapshot, and load [i.e., map] THAT, once more
+			// checking it's the same)
+			const auto snap{ std::filesystem::temp_directory_path() / "t0.snap" };
+			{
+				std::string image;
+				compact.save(image);
+				std::ofstream(snap, std::ios::binary).write(image.data(), std::streamsize(image.size()));
+			}
+			const auto t2g = kr::steady_clock::now();
+			auto t2h{ t2g };
+			size_t loaded_bytes{};
+			bool loaded_same{};
+			{
+				const auto loaded{ js_compact_doc::load(snap) };
+				t2h = kr::steady_clock::now();
+				loaded_bytes = loaded.bytes(), loaded_same = loaded.root().get() == json;
+			}
+			// (... and AGAIN, trusted, i.e., WITHOUT checking every node)
+			const auto t2i = kr::steady_clock::now();
+			auto t2j{ t2i };
+			bool trusted_same{};
+			{
+				const auto loaded{ js_compact_doc::load(snap, true) };
+				t2j = kr::steady_clock::now();
+				trusted_same = loaded.root().get() == json;
+			}
+			// (N.B. - ONLY once unmapped, as some platforms won't remove a mapped file)
+			std::filesystem::remove(snap);
+#ifdef USE_PMR
+			// ... [maybe] parse it AGAIN, this time into an "arena" js_doc...
+			{
+				std::optional<js_doc> doc;
+				const auto t3 = kr::steady_clock::now();
+				const auto n3 = allocs.load();
+				doc.emplace(text);
+				const auto t4 = kr::steady_clock::now();
+				const auto n4 = allocs.load();
+				const auto same = **doc == json;
+				const auto t5 = kr::steady_clock::now();
+				doc.reset();
+				const auto t6 = kr::steady_clock::now();
+				std::cerr << "js_doc parse time="
+					<< kr::duration_cast<kr::microseconds>(t4 - t3).count()
+					<< "mus, release time="
+					<< kr::duration_cast<kr::microseconds>(t6 - t5).count()
+					<< "mus, allocations=" << (n4 - n3)
+					<< " (" << (same ? "same" : "DIFFERENT") << " js_val)" << std::endl;
+			}
+#endif
 			// ... and display first the times, then the stringified output
 			std::cerr << "parse time="
 				<< kr::duration_cast<kr::microseconds>(t1 - t0).count()
@@ -256,6 +563,31 @@ int main(int argc, char* argv[])
 			std::cerr << "to_string time="
 				<< kr::duration_cast<kr::microseconds>(t2 - t1).count()
 				<< "mus" << std::endl;
+			std::cerr << "parse allocations=" << (n1 - n0) << std::endl;
+			std::cerr << "SAX parse time="
+				<< kr::duration_cast<kr::microseconds>(t2a - t2).count()
+				<< "mus, allocations=" << (n2a - n2)
+				<< " (" << c.n << " keys and values)" << std::endl;
+			std::cerr << "push parse time="
+				<< kr::duration_cast<kr::microseconds>(t2b - t2a).count()
+				<< "mus (" << (b.get() == json ? "same" : "DIFFERENT") << " js_val)" << std::endl;
+			std::cerr << "lazy parse time="
+				<< kr::duration_cast<kr::microseconds>(t2c - t2b).count()
+				<< "mus (" << top << " top-level values)" << std::endl;
+			std::cerr << "compact parse time="
+				<< kr::duration_cast<kr::microseconds>(t2d - t2c).count()
+				<< "mus, bytes=" << compact.bytes()
+				<< " (" << (compact_same ? "same" : "DIFFERENT") << " js_val)" << std::endl;
+			std::cerr << "in situ compact parse time="
+				<< kr::duration_cast<kr::microseconds>(t2f - t2e).count()
+				<< "mus, bytes=" << situ.bytes() << std::endl;
+			std::cerr << "snapshot load time="
+				<< kr::duration_cast<kr::microseconds>(t2h - t2g).count()
+				<< "mus, bytes=" << loaded_bytes
+				<< " (" << (loaded_same ? "same" : "DIFFERENT") << " js_val)" << std::endl;
+			std::cerr << "trusted snapshot load time="
+				<< kr::duration_cast<kr::microseconds>(t2j - t2i).count()
+				<< "mus (" << (trusted_same ? "same" : "DIFFERENT") << " js_val)" << std::endl;
 			std::cout << text2 << std::endl;
 		} catch (std::exception& e) {
 			std::cerr << "rmj::parse -> exception, 'what()'="